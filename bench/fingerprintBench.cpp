@@ -0,0 +1,78 @@
+// Micro benchmark for FingerprintLevel against the previous per entry json::parse of the fingerprint.
+// Builds a synthetic inventory of 50k mods with fingerprints shaped like the real ones and reads the
+// level of every one of them with both paths.
+//
+// Build from the repository root, e.g.
+//   g++ -std=c++20 -O2 -Isrc bench/fingerprintBench.cpp src/dataReader/*.cpp src/FileAccess/*.cpp
+//       src/apiParser/apiParser.cpp -lcurl -llzma -lpthread
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "dataReader/playerReader.h"
+
+namespace {
+
+constexpr size_t modCount = 50000;
+constexpr int rounds = 5;
+
+std::vector<std::string> SyntheticFingerprints() {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> level(0, 10);
+    std::uniform_int_distribution<int> shape(0, 9);
+
+    std::vector<std::string> fingerprints;
+    fingerprints.reserve(modCount);
+    for (size_t i = 0; i < modCount; ++i) {
+        const int lvl = level(rng);
+        switch (shape(rng)) {
+            case 0: //lvl is not always the first key
+                fingerprints.push_back("{\"hof\":0,\"pol\":\"AP_ATTACK\",\"lvl\":" + std::to_string(lvl) + "}");
+                break;
+            case 1:
+                fingerprints.push_back("{\"lvl\":" + std::to_string(lvl) + ",\"buffs\":[{\"Tag\":\"x\",\"Value\":12}]}");
+                break;
+            default:
+                fingerprints.push_back("{\"lvl\":" + std::to_string(lvl) + "}");
+                break;
+        }
+    }
+    return fingerprints;
+}
+
+template<typename F>
+double Measure(const char* name, const std::vector<std::string>& fingerprints, F&& levelOf) {
+    double best = 0;
+    long long checksum = 0;
+    for (int round = 0; round < rounds; ++round) {
+        checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const std::string& fingerprint : fingerprints) {
+            checksum += levelOf(fingerprint);
+        }
+        const std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        if (round == 0 || took.count() < best) best = took.count();
+    }
+    std::cout << name << ": " << best << " ms (checksum " << checksum << ")\n";
+    return best;
+}
+
+} // namespace
+
+int main() {
+    const auto fingerprints = SyntheticFingerprints();
+
+    const double parsed = Measure("json::parse", fingerprints, [](const std::string& fingerprint) {
+        return nlohmann::json::parse(fingerprint).value("lvl", -1);
+    });
+    const double scanned = Measure("FingerprintLevel", fingerprints, [](const std::string& fingerprint) {
+        return FingerprintLevel(fingerprint);
+    });
+
+    std::cout << modCount << " fingerprints, speedup " << parsed / scanned << "x\n";
+    return 0;
+}
@@ -0,0 +1,376 @@
+// Headless benchmark of the dataReader pipeline, no Qt involved.
+// Runs the same steps the app does on startup and on every sync and reports wall time, heap
+// allocations and peak RSS per stage, one json object per line on stdout (a readable table goes to stderr).
+//
+// Like the app it reads everything relative to the working directory ('../data/...'), so run it from a
+// directory next to data/, e.g. the build directory. The player file is replaced by a synthetic inventory
+// for the duration of the run and put back afterwards; catalog snapshots go to a temporary directory so the
+// app's own ones in data/Cache are left alone.
+//
+//   pipelineBench [--scales 1,10,100] [--player file.json]
+//
+// --scales   inventory sizes as multiples of the export contents (default 1,10,100)
+// --player   use this player_data.json instead of the synthetic inventory, reported as scale 0
+//
+// Build from the repository root, e.g.
+//   g++ -std=c++20 -O2 -Isrc bench/pipelineBench.cpp src/dataReader/*.cpp src/FileAccess/*.cpp
+//       src/apiParser/apiParser.cpp -lcurl -llzma -lpthread
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "dataReader/catalogSnapshot.h"
+#include "dataReader/dataReader.h"
+#include "FileAccess/FileAccess.h"
+
+// ---------- allocation counting ----------
+
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+//the array and nothrow forms fall back to these; kept out of line, inlined into a caller gcc sees free() on
+//memory from operator new and warns about a mismatch (-Wmismatched-new-delete)
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// ---------- peak RSS ----------
+
+//the peak only ever grows; Linux can reset it so every stage gets its own value, elsewhere (or on kernels
+//that ignore clear_refs) the reported number is the peak of the whole run so far
+void ResetPeakRss() {
+#ifdef __linux__
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+uint64_t PeakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1024;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) return std::strtoull(line.c_str() + 6, nullptr, 10);
+    }
+    return 0;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024; //bytes on macOS
+#endif
+}
+
+// ---------- stages ----------
+
+struct StageResult {
+    std::string stage;
+    int scale = 0;
+    double wallMs = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t peakRssKb = 0;
+    size_t items = 0;
+};
+
+std::vector<StageResult> results;
+
+// 'body' returns the number of items the stage produced, only for the report
+void Stage(const std::string& name, int scale, const std::function<size_t()>& body) {
+    FlushLog(); //keep the log writer of the previous stage out of this one
+    ResetPeakRss();
+    const uint64_t allocationsBefore = allocationCount.load();
+    const uint64_t bytesBefore = allocatedBytes.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    const size_t items = body();
+
+    const std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+    StageResult result;
+    result.stage = name;
+    result.scale = scale;
+    result.wallMs = took.count();
+    result.allocations = allocationCount.load() - allocationsBefore;
+    result.bytes = allocatedBytes.load() - bytesBefore;
+    result.peakRssKb = PeakRssKb();
+    result.items = items;
+    results.push_back(result);
+
+    nlohmann::json line = {
+        {"stage", result.stage}, {"scale", result.scale}, {"wall_ms", result.wallMs},
+        {"allocations", result.allocations}, {"allocated_bytes", result.bytes},
+        {"peak_rss_kb", result.peakRssKb}, {"items", result.items}
+    };
+    std::cout << line.dump() << std::endl;
+}
+
+// ---------- synthetic inventory ----------
+
+std::string Quoted(const std::string& value) {
+    return nlohmann::json(value).dump();
+}
+
+// Every id the catalogs know about shows up 'scale' times, upgrades get distinct ItemIds and levels
+// like the real file. Written by hand so generating 100x does not itself need a huge json tree.
+void WriteSyntheticPlayer(const std::string& path, int scale,
+                          const std::vector<Recipe>& recipes, const std::vector<Relic>& relics,
+                          const std::vector<Arcane>& arcanes, const std::vector<Mod>& mods) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    bool first = true;
+    auto separator = [&] {
+        if (!first) out << ',';
+        first = false;
+    };
+
+    out << "{\"PlayerLevel\":30,\"Recipes\":[";
+    first = true;
+    for (int round = 0; round < scale; ++round) {
+        for (const auto& recipe : recipes) {
+            separator();
+            out << "{\"ItemType\":" << Quoted(recipe.mainItem.getId()) << ",\"ItemCount\":" << (round + 1) << '}';
+        }
+    }
+
+    out << "],\"MiscItems\":[";
+    first = true;
+    for (int round = 0; round < scale; ++round) {
+        for (const auto& recipe : recipes) {
+            for (const auto& sub : recipe.subItems) {
+                separator();
+                out << "{\"ItemType\":" << Quoted(sub.getId()) << ",\"ItemCount\":" << (round + 2) << '}';
+            }
+        }
+        for (const auto& relic : relics) {
+            separator();
+            out << "{\"ItemType\":" << Quoted(relic.mainItem.getId()) << ",\"ItemCount\":" << (round + 1) << '}';
+        }
+    }
+
+    out << "],\"RawUpgrades\":[";
+    first = true;
+    for (int round = 0; round < scale; ++round) {
+        for (const auto& mod : mods) {
+            separator();
+            out << "{\"ItemType\":" << Quoted(mod.getId()) << ",\"ItemCount\":3}";
+        }
+    }
+
+    out << "],\"Upgrades\":[";
+    first = true;
+    size_t oid = 0;
+    for (int round = 0; round < scale; ++round) {
+        for (const auto& mod : mods) {
+            separator();
+            out << "{\"UpgradeFingerprint\":\"{\\\"lvl\\\":" << (oid % 11) << "}\",\"ItemType\":" << Quoted(mod.getId())
+                << ",\"ItemId\":{\"$oid\":\"" << oid << "\"}}";
+            ++oid;
+        }
+        for (const auto& arcane : arcanes) {
+            separator();
+            out << "{\"UpgradeFingerprint\":\"{\\\"lvl\\\":" << (oid % 6) << "}\",\"ItemType\":" << Quoted(arcane.getId())
+                << ",\"ItemId\":{\"$oid\":\"" << oid << "\"}}";
+            ++oid;
+        }
+        separator();
+        out << "{\"UpgradeFingerprint\":\"{\\\"compat\\\":\\\"/Lotus/Weapons/Tenno/Rifle/Rifle\\\",\\\"lvl\\\":8}\","
+            << "\"ItemType\":\"/Lotus/Upgrades/Mods/Randomized/LotusRifleRandomModRare\","
+            << "\"ItemId\":{\"$oid\":\"" << oid << "\"}}";
+        ++oid;
+    }
+
+    out << "],\"XPInfo\":[";
+    first = true;
+    for (int round = 0; round < scale; ++round) {
+        for (const auto& recipe : recipes) {
+            separator();
+            out << "{\"ItemType\":" << Quoted(recipe.mainItem.getCraftedId()) << ",\"XP\":" << (900000 * (round + 1)) << '}';
+        }
+    }
+
+    out << "],\"Missions\":[";
+    first = true;
+    const auto regions = ReadData(DataType::Regions);
+    if (auto it = regions->find("ExportRegions"); it != regions->end()) {
+        int index = 0;
+        for (const auto& node : *it) {
+            separator();
+            out << "{\"Tag\":" << Quoted(node.value("uniqueName", "")) << ",\"Completes\":" << (index % 3)
+                << ",\"Tier\":" << (index % 2) << '}';
+            ++index;
+        }
+    }
+
+    out << "],\"PlayerSkills\":{\"LPP_SPACE\":10,\"LPS_PILOTING\":7,\"LPS_GUNNERY\":10,"
+        << "\"LPP_DRIFTER\":10,\"LPS_DRIFT_RIDING\":6,\"LPS_DRIFT_COMBAT\":5}}";
+}
+
+// moves the real player file out of the way and restores it on exit
+class PlayerFileGuard {
+public:
+    PlayerFileGuard() : path(PathFromDataType(DataType::Player)), backup(path + ".bench-backup") {
+        std::error_code ec;
+        hadFile = std::filesystem::exists(path, ec);
+        if (hadFile) std::filesystem::rename(path, backup, ec);
+    }
+
+    ~PlayerFileGuard() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (hadFile) std::filesystem::rename(backup, path, ec);
+    }
+
+    PlayerFileGuard(const PlayerFileGuard&) = delete;
+    PlayerFileGuard& operator=(const PlayerFileGuard&) = delete;
+
+    const std::string path;
+
+private:
+    const std::string backup;
+    bool hadFile = false;
+};
+
+std::vector<int> ParseScales(const std::string& list) {
+    std::vector<int> scales;
+    std::stringstream stream(list);
+    std::string part;
+    while (std::getline(stream, part, ',')) {
+        const int scale = std::atoi(part.c_str());
+        if (scale > 0) scales.push_back(scale);
+    }
+    return scales;
+}
+
+template<typename T>
+size_t CountAll(std::vector<T>& catalog) {
+    for (auto& entry : catalog) {
+        if constexpr (std::is_same_v<T, Recipe>) UpdateCounts(entry, false);
+        else if constexpr (std::is_same_v<T, Relic>) UpdateCounts(entry, true);
+        else UpdateCounts(entry);
+    }
+    return catalog.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<int> scales = {1, 10, 100};
+    std::string playerFile;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--scales" && i + 1 < argc) {
+            scales = ParseScales(argv[++i]);
+        } else if (arg == "--player" && i + 1 < argc) {
+            playerFile = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--scales 1,10,100] [--player file.json]\n";
+            return 2;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(logPath).parent_path(), ec);
+    //a fresh directory, otherwise the catalogs come from the snapshots of an earlier run and the build is never measured
+    const std::filesystem::path snapshotDirectory = std::filesystem::temp_directory_path(ec) /
+        ("pipelineBench-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::remove_all(snapshotDirectory, ec);
+    SetSnapshotDirectory(snapshotDirectory.string());
+
+    //read up front, it may well be the player file of this data directory that the guard moves away
+    std::string playerContent;
+    if (!playerFile.empty()) {
+        std::ifstream input(playerFile, std::ios::binary);
+        if (!input) {
+            std::cerr << "could not read " << playerFile << "\n";
+            return 1;
+        }
+        playerContent.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    PlayerFileGuard player;
+
+    std::vector<Recipe> recipes;
+    std::vector<Relic> relics;
+    std::vector<Arcane> arcanes;
+    std::vector<Mod> mods;
+
+    Stage("maps", 0, [] {
+        EnsureGameDataMaps();
+        return size_t{0};
+    });
+    Stage("recipes", 0, [&] { recipes = GetRecipes(); return recipes.size(); });
+    Stage("relics", 0, [&] { relics = GetRelics(); return relics.size(); });
+    Stage("arcanes", 0, [&] { arcanes = GetArcanes(); return arcanes.size(); });
+    Stage("mods", 0, [&] { mods = GetMods(); return mods.size(); });
+
+    //second round is what a normal start sees once the catalog snapshots exist
+    Stage("recipes.snapshot", 0, [&] { recipes = GetRecipes(); return recipes.size(); });
+    Stage("relics.snapshot", 0, [&] { relics = GetRelics(); return relics.size(); });
+    Stage("arcanes.snapshot", 0, [&] { arcanes = GetArcanes(); return arcanes.size(); });
+    Stage("mods.snapshot", 0, [&] { mods = GetMods(); return mods.size(); });
+
+    auto runInventory = [&](int scale) {
+        std::shared_ptr<const InventorySnapshot> snapshot;
+        Stage("inventory", scale, [&] {
+            snapshot = BuildInventorySnapshot();
+            return snapshot->counts.size() + snapshot->upgrades.size() + snapshot->xp.size();
+        });
+        ApplyInventorySnapshot(snapshot);
+        Stage("counts", scale, [&] {
+            return CountAll(recipes) + CountAll(relics) + CountAll(arcanes) + CountAll(mods);
+        });
+    };
+
+    if (!playerFile.empty()) {
+        std::ofstream(player.path, std::ios::binary | std::ios::trunc) << playerContent;
+        runInventory(0);
+    } else {
+        for (int scale : scales) {
+            WriteSyntheticPlayer(player.path, scale, recipes, relics, arcanes, mods);
+            runInventory(scale);
+        }
+    }
+
+    std::cerr << "\nstage              scale    wall ms     allocs        MiB   peak RSS MiB   items\n";
+    for (const auto& result : results) {
+        std::fprintf(stderr, "%-18s %5d %10.1f %10llu %10.1f %14.1f %7zu\n",
+                     result.stage.c_str(), result.scale, result.wallMs,
+                     static_cast<unsigned long long>(result.allocations), result.bytes / 1048576.0,
+                     result.peakRssKb / 1024.0, result.items);
+    }
+
+    std::filesystem::remove_all(snapshotDirectory, ec);
+    ShutdownLog();
+    return 0;
+}
@@ -0,0 +1,679 @@
+// Generates a synthetic but structurally faithful export set plus a matching player_data.json, for scale
+// and stress testing of the dataReader pipeline (see pipelineBench.cpp).
+//
+//   syntheticData [--out dir] [--scale n] [--inventory n] [--seed n]
+//
+// --out        target directory, gets Warframe/ and Player/ in the layout of data/ (default synthetic-data)
+// --scale      export size as a multiple of roughly one real export set (default 1)
+// --inventory  how often every owned item shows up in the player file (default 1)
+// --seed       seed for counts, levels and xp (default 1)
+//
+// The exports contain the ids the filters in BuildRecipes, BuildRelics, BuildArcanes and BuildMods look
+// for (Kuva, Tenet, ModularMelee, PvPVariant, Doppelganger, kitguns, amps, k-drives, exalted weapons,
+// antigens, duplicates, nameless entries, relic Bronze/Silver/Gold/Platinum variants, blacklisted and
+// duplicate arcanes, rivens, ...), so every branch of the real code gets exercised.
+//
+// To benchmark with it, point the data/ the app reads at the output, e.g.
+//   syntheticData --out scratch/data --scale 10 && mkdir -p scratch/run && cd scratch/run
+//   pipelineBench --player ../data/Player/player_data.json
+//
+// Build from the repository root, e.g.
+//   g++ -std=c++20 -O2 bench/syntheticData.cpp
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Writes {"Key":[...],"Other":[...]} one entry at a time, so even large scales never hold a whole
+// export in memory.
+class ExportWriter {
+public:
+    explicit ExportWriter(const std::filesystem::path& path) : out(path, std::ios::binary | std::ios::trunc) {
+        if (!out) {
+            std::cerr << "could not write " << path << "\n";
+            std::exit(1);
+        }
+        out << '{';
+    }
+
+    ~ExportWriter() {
+        out << "}\n";
+    }
+
+    ExportWriter(const ExportWriter&) = delete;
+    ExportWriter& operator=(const ExportWriter&) = delete;
+
+    void value(const std::string& key, const json& value) {
+        keyOf(key);
+        out << value.dump();
+    }
+
+    void begin(const std::string& key) {
+        keyOf(key);
+        out << '[';
+        firstEntry = true;
+    }
+
+    void add(const json& entry) {
+        if (!firstEntry) out << ',';
+        firstEntry = false;
+        out << entry.dump();
+    }
+
+    void end() {
+        out << ']';
+    }
+
+private:
+    void keyOf(const std::string& key) {
+        if (!firstKey) out << ',';
+        firstKey = false;
+        out << json(key).dump() << ':';
+    }
+
+    std::ofstream out;
+    bool firstKey = true;
+    bool firstEntry = true;
+};
+
+struct Item {
+    std::string id;
+    std::string name;
+};
+
+// something that has a blueprint in ExportRecipes
+struct Craftable {
+    Item result;
+    std::string blueprint;
+    std::vector<std::string> ingredients;
+};
+
+struct Relic {
+    std::string base; //without the Bronze/Silver/Gold/Platinum suffix
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> rewards; //rewardName, rarity
+};
+
+struct Arcane {
+    Item item;
+    std::string rarity; //empty for the entries DE left without one
+    bool hasLevelStats = true;
+};
+
+struct Mod {
+    Item item;
+    std::string rarity;
+    int baseDrain = 0;
+    int fusionLimit = 0;
+};
+
+struct World {
+    std::vector<Item> warframes;
+    std::vector<json> weapons; //whole entries, the filter cases need productCategory and missing names
+    std::vector<json> sentinels;
+    std::vector<Item> resources;
+    std::vector<Craftable> recipes;
+    std::vector<Relic> relics;
+    std::vector<Arcane> arcanes;
+    std::vector<Mod> mods;
+    std::vector<Item> avionics;
+    std::vector<Item> customs;
+    std::vector<Item> regions;
+    std::vector<std::string> systems;
+    std::vector<std::string> primeParts; //blueprints of prime components, the pool relic rewards come from
+    std::vector<std::string> masteryItems; //everything XPInfo can list
+};
+
+const std::vector<std::string> basicResources = {
+    "/Lotus/Types/Items/MiscItems/Alertium", "/Lotus/Types/Items/MiscItems/Morphic",
+    "/Lotus/Types/Items/MiscItems/Salvage", "/Lotus/Types/Items/MiscItems/Rubedo",
+    "/Lotus/Types/Items/MiscItems/Circuits", "/Lotus/Types/Items/MiscItems/OxiumAlloy",
+    "/Lotus/Types/Items/MiscItems/Neurode", "/Lotus/Types/Items/MiscItems/Gallium"
+};
+
+const std::vector<std::string> blacklistedArcanes = {
+    "/Lotus/Upgrades/CosmeticEnhancers/Defensive/CorrosiveProcResist",
+    "/Lotus/Upgrades/CosmeticEnhancers/Defensive/GasProcResist",
+    "/Lotus/Upgrades/CosmeticEnhancers/Defensive/ImpactProcResist",
+    "/Lotus/Upgrades/CosmeticEnhancers/Defensive/PoisonProcResist",
+    "/Lotus/Upgrades/CosmeticEnhancers/Defensive/PunctureProcResist",
+    "/Lotus/Upgrades/CosmeticEnhancers/Utility/DamageReductionDuringRevive",
+    "/Lotus/Upgrades/CosmeticEnhancers/Utility/SlowerBleedOutOnPredeath"
+};
+
+const std::vector<std::string> rarities = {"COMMON", "UNCOMMON", "RARE", "LEGENDARY"};
+
+std::string Num(int value) {
+    return std::to_string(value);
+}
+
+// adds a component with its own blueprint and returns the component id
+std::string AddComponent(World& world, const std::string& folder, const std::string& owner,
+                         const std::string& ownerName, const std::string& part, bool prime) {
+    const std::string component = folder + owner + part + "Component";
+    world.resources.push_back({component, ownerName + " " + part});
+    const std::string blueprint = folder + owner + part + "Blueprint";
+    world.recipes.push_back({{component, ownerName + " " + part}, blueprint,
+                             {basicResources[part.size() % basicResources.size()], basicResources[0]}});
+    if (prime) {
+        world.primeParts.push_back(blueprint);
+    }
+    return component;
+}
+
+void AddWarframes(World& world, int scale) {
+    const std::string folder = "/Lotus/Types/Recipes/WarframeRecipes/";
+    for (int i = 0; i < 90 * scale; ++i) {
+        const bool prime = i % 3 == 2; //prime version of the frame two before it
+        const std::string base = "Synth" + Num(prime ? i - 2 : i);
+        const std::string owner = prime ? base + "Prime" : base;
+        const std::string name = prime ? base + " Prime" : base;
+        const std::string id = "/Lotus/Powersuits/" + base + "/" + owner;
+
+        world.warframes.push_back({id, name});
+        world.masteryItems.push_back(id);
+        std::vector<std::string> ingredients;
+        for (const char* part : {"Chassis", "Helmet", "Systems"}) {
+            ingredients.push_back(AddComponent(world, folder, owner, name, part, prime));
+        }
+        ingredients.push_back(basicResources[i % basicResources.size()]);
+        world.recipes.push_back({{id, name}, folder + owner + "Blueprint", ingredients});
+        if (prime) world.primeParts.push_back(folder + owner + "Blueprint");
+    }
+
+    //archwings carry a prefix in their name, necramechs have no blueprint of their own
+    for (int i = 0; i < 5 * scale; ++i) {
+        const std::string id = "/Lotus/Powersuits/Archwing/Wing" + Num(i) + "/Wing" + Num(i) + "JetPack";
+        world.warframes.push_back({id, "<ARCHWING> Wing " + Num(i)});
+        world.masteryItems.push_back(id);
+        world.recipes.push_back({{id, "Wing " + Num(i)}, "/Lotus/Types/Recipes/ArchwingRecipes/Wing" + Num(i) + "Blueprint",
+                                 {basicResources[1], basicResources[2]}});
+    }
+    for (int i = 0; i < 2 * scale; ++i) {
+        const std::string id = "/Lotus/Powersuits/EntratiMech/Mech" + Num(i);
+        world.warframes.push_back({id, "Mech " + Num(i)});
+        world.masteryItems.push_back(id);
+    }
+}
+
+json WeaponEntry(const std::string& id, const std::string& name, const std::string& category) {
+    json entry = {{"uniqueName", id}, {"productCategory", category}, {"masteryReq", 0}, {"totalDamage", 40}};
+    if (!name.empty()) entry["name"] = name;
+    return entry;
+}
+
+void AddWeapons(World& world, int scale) {
+    const std::string folder = "/Lotus/Types/Recipes/Weapons/";
+    const std::vector<std::pair<std::string, std::string>> kinds = {
+        {"/Lotus/Weapons/Tenno/LongGuns/", "LongGuns"}, {"/Lotus/Weapons/Tenno/Pistol/", "Pistols"},
+        {"/Lotus/Weapons/Tenno/Melee/", "Melee"}
+    };
+
+    for (int i = 0; i < 300 * scale; ++i) {
+        const auto& [path, category] = kinds[i % kinds.size()];
+        std::string id;
+        std::string name;
+        bool craftable = true;
+        bool prime = false;
+        switch (i % 10) {
+            case 0: case 1: case 2: case 3:
+                id = path + "Synth" + Num(i) + "/Synth" + Num(i);
+                name = "Synth " + Num(i);
+                break;
+            case 4: case 5:
+                id = path + "Synth" + Num(i) + "/PrimeSynth" + Num(i);
+                name = "Synth " + Num(i) + " Prime";
+                prime = true;
+                break;
+            case 6: //lich weapons are not crafted
+                id = "/Lotus/Weapons/Grineer/KuvaLich/" + category + "/KuvaSynth" + Num(i) + "/KuvaSynth" + Num(i) + "Weapon";
+                name = "Kuva Synth " + Num(i);
+                craftable = false;
+                break;
+            case 7:
+                id = "/Lotus/Weapons/Corpus/BoardExec/" + category + "/CrpTenetSynth" + Num(i) + "/CrpTenetSynth" + Num(i);
+                name = "Tenet Synth " + Num(i);
+                craftable = false;
+                break;
+            case 8:
+                id = path + "Synth" + Num(i) + "/Synth" + Num(i) + "Vandal";
+                name = "Synth " + Num(i) + " Vandal";
+                craftable = false;
+                break;
+            default:
+                id = path + "Synth" + Num(i) + "/Synth" + Num(i) + "Wraith";
+                name = "Synth " + Num(i) + " Wraith";
+                break;
+        }
+
+        world.weapons.push_back(WeaponEntry(id, name, category));
+        world.masteryItems.push_back(id);
+        if (!craftable) continue;
+
+        const std::string owner = "Synth" + Num(i) + (prime ? "Prime" : "");
+        std::vector<std::string> ingredients;
+        if (prime) {
+            for (const char* part : {"Barrel", "Receiver", "Stock"}) {
+                ingredients.push_back(AddComponent(world, folder, owner, name, part, true));
+            }
+        }
+        ingredients.push_back(basicResources[i % basicResources.size()]);
+        world.recipes.push_back({{id, name}, folder + owner + "Blueprint", ingredients});
+        if (prime) world.primeParts.push_back(folder + owner + "Blueprint");
+    }
+
+    // one of each case BuildRecipes filters on (or explicitly keeps), per scale step
+    for (int i = 0; i < scale; ++i) {
+        const std::string n = Num(i);
+        auto add = [&](const std::string& id, const std::string& name, const std::string& category, bool mastery) {
+            world.weapons.push_back(WeaponEntry(id, name, category));
+            if (mastery) world.masteryItems.push_back(id);
+        };
+        add("/Lotus/Weapons/Ostron/Melee/ModularMelee01/Tip/TipSynth" + n, "Synth Zaw " + n, "Melee", true);
+        add("/Lotus/Weapons/Ostron/Melee/ModularMelee01/Handle/HandleSynth" + n, "Synth Handle " + n, "Melee", false);
+        add("/Lotus/Weapons/Ostron/Melee/ModularMelee01/Tip/PvPVariantTipSynth" + n, "Synth Zaw " + n, "Melee", false);
+        add("/Lotus/Weapons/Tenno/Grimoire/TnDoppelgangerSynth" + n, "Synth Grimoire " + n, "LongGuns", false);
+        add("/Lotus/Weapons/SolarisUnited/Primary/SUModularPrimarySet1/Barrels/SUModularBarrelSynth" + n, "Synth Kitgun " + n, "Pistols", true);
+        add("/Lotus/Weapons/SolarisUnited/Primary/SUModularPrimarySet1/Handles/SUModularGripSynth" + n, "Synth Grip " + n, "Pistols", false);
+        add("/Lotus/Weapons/Infested/Pistols/InfKitGun/Barrels/InfKitGunBarrelSynth" + n, "Synth Catchmoon " + n, "Pistols", true);
+        add("/Lotus/Weapons/Infested/Pistols/InfKitGun/Handles/InfKitGunGripSynth" + n, "Synth Infested Grip " + n, "Pistols", false);
+        add("/Lotus/Weapons/Sentients/OperatorAmplifiers/Set1/Barrel/SentAmpBarrelSynth" + n, "Synth Amp " + n, "OperatorAmps", true);
+        add("/Lotus/Weapons/Sentients/OperatorAmplifiers/Set1/Prism/SentAmpPrismSynth" + n, "Synth Prism " + n, "OperatorAmps", false);
+        add("/Lotus/Types/Vehicles/Hoverboard/HoverboardParts/PartComponents/DeckSynth" + n, "Synth Deck " + n, "Hoverboards", true);
+        add("/Lotus/Types/Vehicles/Hoverboard/HoverboardParts/PartComponents/EngineSynth" + n, "Synth Engine " + n, "Hoverboards", false);
+        add("/Lotus/Powersuits/Synth" + n + "/SynthExaltedBlade" + n, "Exalted Synth " + n, "SpecialItems", false);
+        add("/Lotus/Types/Friendly/Pets/CreaturePets/WoundedInfestedSynth" + n, "Synth Predasite " + n, "SentinelWeapons", false);
+        add("/Lotus/Types/Friendly/Pets/MoaPets/MoaPetParts/MoaPetHeadSynth" + n, "Synth Moa Head " + n, "SentinelWeapons", true);
+        add("/Lotus/Types/Game/KubrowPet/Eggs/PetAntigenSynth" + n, "Synth Antigen " + n, "SentinelWeapons", false);
+        add("/Lotus/Weapons/Tenno/LongGuns/Synth0/Synth0", "Synth 0", "LongGuns", false); //duplicate id
+        add("/Lotus/Weapons/Tenno/LongGuns/NamelessSynth" + n, "", "LongGuns", false);
+    }
+}
+
+void AddSentinels(World& world, int scale) {
+    for (int i = 0; i < 12 * scale; ++i) {
+        const std::string id = "/Lotus/Types/Sentinels/SentinelPowersuits/Synth" + Num(i) + "PowerSuit";
+        const std::string name = "Synth Sentinel " + Num(i);
+        world.sentinels.push_back({{"uniqueName", id}, {"name", name}, {"productCategory", "Sentinels"}});
+        world.masteryItems.push_back(id);
+        world.recipes.push_back({{id, name}, "/Lotus/Types/Recipes/Sentinels/Synth" + Num(i) + "Blueprint",
+                                 {basicResources[i % basicResources.size()]}});
+    }
+    for (int i = 0; i < 4 * scale; ++i) {
+        //kavats are SpecialItems too but count for mastery
+        const std::string id = "/Lotus/Powersuits/Khora/Kavat/Synth" + Num(i) + "KavatPowerSuit";
+        world.sentinels.push_back({{"uniqueName", id}, {"name", "Synth Kavat " + Num(i)}, {"productCategory", "SpecialItems"}});
+        world.masteryItems.push_back(id);
+    }
+}
+
+void AddRelics(World& world, int scale) {
+    const std::vector<std::string> tiers = {"Lith", "Meso", "Neo", "Axi"};
+    const std::string forma = "/Lotus/StoreItems/Types/Recipes/Components/FormaBlueprint";
+    world.recipes.push_back({{"/Lotus/Types/Items/MiscItems/Forma", "Forma"},
+                             "/Lotus/Types/Recipes/Components/FormaBlueprint", {basicResources[3]}});
+    world.resources.push_back({"/Lotus/Types/Items/MiscItems/Forma", "Forma"});
+
+    size_t part = 0;
+    for (int i = 0; i < 175 * scale; ++i) {
+        Relic relic;
+        relic.base = "/Lotus/Types/Game/Projections/T" + Num(i % 4 + 1) + "VoidProjectionSynth" + Num(i);
+        relic.name = tiers[i % 4] + " S" + Num(i) + " Relic";
+        const char* rarity[] = {"COMMON", "COMMON", "COMMON", "UNCOMMON", "UNCOMMON", "RARE"};
+        for (int r = 0; r < 6; ++r) {
+            std::string reward;
+            if (r == 0) {
+                reward = forma;
+            } else if (r == 4 && !world.mods.empty()) { //not everything is a blueprint
+                std::string mod = world.mods[(i * 7) % world.mods.size()].item.id;
+                reward = "/Lotus/StoreItems" + mod.substr(std::string("/Lotus").size());
+            } else if (!world.primeParts.empty()) {
+                const std::string& bp = world.primeParts[part++ % world.primeParts.size()];
+                reward = "/Lotus/StoreItems" + bp.substr(std::string("/Lotus").size());
+            }
+            relic.rewards.emplace_back(reward, rarity[r]);
+        }
+        world.relics.push_back(std::move(relic));
+    }
+}
+
+void AddArcanes(World& world, int scale) {
+    const std::vector<std::string> folders = {"Offensive", "Defensive", "Utility"};
+    for (int i = 0; i < 150 * scale; ++i) {
+        Arcane arcane;
+        arcane.item.id = "/Lotus/Upgrades/CosmeticEnhancers/" + folders[i % 3] + "/SynthArcane" + Num(i);
+        //every 15th shares its name with the one before, every 10th has no rarity
+        arcane.item.name = "Arcane Synth " + Num(i % 15 == 14 ? i - 1 : i);
+        arcane.rarity = i % 10 == 9 ? "" : rarities[i % 4];
+        arcane.hasLevelStats = i % 50 != 49;
+        world.arcanes.push_back(std::move(arcane));
+    }
+    for (const auto& id : blacklistedArcanes) {
+        world.arcanes.push_back({{id, "Blacklisted " + id.substr(id.rfind('/') + 1)}, "COMMON", true});
+    }
+}
+
+void AddMods(World& world, int scale) {
+    const std::vector<std::string> folders = {"Rifle", "Pistol", "Melee", "Warframe", "Sentinel", "Shotgun"};
+    for (int i = 0; i < 1500 * scale; ++i) {
+        world.mods.push_back({{"/Lotus/Upgrades/Mods/" + folders[i % folders.size()] + "/SynthMod" + Num(i), "Synth Mod " + Num(i)},
+                              rarities[i % 4], 2 + i % 6, 3 + i % 8});
+    }
+    for (int i = 0; i < 4 * scale; ++i) {
+        world.mods.push_back({{"/Lotus/Upgrades/Mods/Randomized/LotusRandomModSynth" + Num(i), "Synth Riven Mod"}, "RARE", 18, 8});
+    }
+    world.mods.push_back({{"/Lotus/Upgrades/Mods/Fusers/UnfusedArtifact", "Unfused Artifact"}, "COMMON", 0, 0});
+    for (int i = 0; i < 20 * scale; ++i) {
+        world.avionics.push_back({"/Lotus/Types/Game/CrewShip/CrewShipUpgrades/SynthAvionic" + Num(i), "Synth Avionic " + Num(i)});
+    }
+}
+
+void AddWorld(World& world, int scale) {
+    world.systems = {"Mercury", "Venus", "Earth", "Lua", "Mars", "Deimos", "Phobos", "Ceres", "Jupiter",
+                     "Europa", "Saturn", "Uranus", "Neptune", "Pluto", "Sedna", "Eris", "Void", "Kuva Fortress"};
+    for (int i = 0; i < 260 * scale; ++i) {
+        world.regions.push_back({"SolNode" + Num(i), "Synth Node " + Num(i)});
+    }
+    for (int i = 0; i < 50 * scale; ++i) {
+        world.customs.push_back({"/Lotus/Types/Items/ShipDecos/SynthDeco" + Num(i), "Synth Deco " + Num(i)});
+    }
+    for (int i = 0; i < 40 * scale; ++i) {
+        world.resources.push_back({"/Lotus/Types/Items/MiscItems/SynthResource" + Num(i), "Synth Resource " + Num(i)});
+    }
+    for (const auto& id : basicResources) {
+        world.resources.push_back({id, id.substr(id.rfind('/') + 1)});
+    }
+}
+
+// ---------- writing ----------
+
+std::string Texture(const std::string& id) {
+    return "/Lotus/Interface/Icons/Synth" + id.substr(id.rfind('/')) + ".png!00_synth";
+}
+
+void WriteExports(const World& world, const std::filesystem::path& dir) {
+    {
+        ExportWriter out(dir / "ExportWarframes_en.json");
+        out.begin("ExportWarframes");
+        for (const auto& item : world.warframes) {
+            out.add({{"uniqueName", item.id}, {"name", item.name}, {"health", 300}, {"masteryReq", 0},
+                     {"productCategory", "Suits"}});
+        }
+        out.end();
+        out.begin("ExportAbilities");
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportWeapons_en.json");
+        out.begin("ExportWeapons");
+        for (const auto& entry : world.weapons) out.add(entry);
+        out.end();
+        out.begin("ExportRailjackWeapons");
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportSentinels_en.json");
+        out.begin("ExportSentinels");
+        for (const auto& entry : world.sentinels) out.add(entry);
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportResources_en.json");
+        out.begin("ExportResources");
+        for (const auto& item : world.resources) {
+            out.add({{"uniqueName", item.id}, {"name", item.name}, {"codexSecret", false}});
+        }
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportCustoms_en.json");
+        out.begin("ExportCustoms");
+        for (const auto& item : world.customs) {
+            out.add({{"uniqueName", item.id}, {"name", item.name}, {"codexSecret", false}});
+        }
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportRecipes_en.json");
+        out.begin("ExportRecipes");
+        for (const auto& recipe : world.recipes) {
+            json ingredients = json::array();
+            for (const auto& ingredient : recipe.ingredients) {
+                ingredients.push_back({{"ItemType", ingredient}, {"ItemCount", 1}, {"ProductCategory", "MiscItems"}});
+            }
+            out.add({{"uniqueName", recipe.blueprint}, {"resultType", recipe.result.id}, {"buildPrice", 15000},
+                     {"buildTime", 43200}, {"num", 1}, {"ingredients", ingredients}, {"secretIngredients", json::array()}});
+        }
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportRelicArcane_en.json");
+        out.begin("ExportRelicArcane");
+        for (const auto& relic : world.relics) {
+            json rewards = json::array();
+            for (const auto& [reward, rarity] : relic.rewards) {
+                rewards.push_back({{"rewardName", reward}, {"rarity", rarity}, {"tier", 0}, {"itemCount", 1}});
+            }
+            for (const char* variant : {"Bronze", "Silver", "Gold", "Platinum"}) {
+                out.add({{"uniqueName", relic.base + variant}, {"name", relic.name}, {"codexSecret", false},
+                         {"relicRewards", rewards}});
+            }
+        }
+        for (const auto& arcane : world.arcanes) {
+            json entry = {{"uniqueName", arcane.item.id}, {"name", arcane.item.name}, {"codexSecret", false}};
+            if (!arcane.rarity.empty()) entry["rarity"] = arcane.rarity;
+            if (arcane.hasLevelStats) {
+                json levels = json::array();
+                for (int rank = 0; rank < 6; ++rank) {
+                    levels.push_back({{"stats", json::array({"On Synth:\r\n+" + Num((rank + 1) * 10) + "% Synthetic"})}});
+                }
+                entry["levelStats"] = levels;
+            }
+            out.add(entry);
+        }
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportUpgrades_en.json");
+        out.begin("ExportUpgrades");
+        for (const auto& mod : world.mods) {
+            out.add({{"uniqueName", mod.item.id}, {"name", mod.item.name}, {"polarity", "AP_ATTACK"},
+                     {"rarity", mod.rarity}, {"codexSecret", false}, {"baseDrain", mod.baseDrain},
+                     {"fusionLimit", mod.fusionLimit}, {"type", "PRIMARY"}});
+        }
+        out.end();
+        out.begin("ExportModSet");
+        out.end();
+        out.begin("ExportAvionics");
+        for (const auto& item : world.avionics) {
+            out.add({{"uniqueName", item.id}, {"name", item.name}, {"rarity", "COMMON"}, {"baseDrain", 4}, {"fusionLimit", 5}});
+        }
+        out.end();
+        out.begin("ExportFocusUpgrades");
+        out.end();
+    }
+    {
+        ExportWriter out(dir / "ExportRegions_en.json");
+        out.begin("ExportRegions");
+        for (size_t i = 0; i < world.regions.size(); ++i) {
+            out.add({{"uniqueName", world.regions[i].id}, {"name", world.regions[i].name}, {"systemIndex", i % world.systems.size()},
+                     {"systemName", world.systems[i % world.systems.size()]}, {"nodeType", 0}, {"masteryReq", 0}});
+        }
+        out.end();
+    }
+    {
+        //a flat tag -> xp object, not an export
+        json xp = json::object();
+        for (size_t i = 0; i < world.regions.size(); ++i) {
+            xp[world.regions[i].id] = i % 5 == 0 ? 0 : static_cast<int>(24 + (i * 37) % 160);
+        }
+        std::ofstream(dir / "XpValues.json", std::ios::binary | std::ios::trunc) << xp.dump();
+    }
+    {
+        ExportWriter out(dir / "ExportManifest.json");
+        out.begin("Manifest");
+        auto add = [&](const std::string& id) {
+            out.add({{"uniqueName", id}, {"textureLocation", Texture(id)}});
+        };
+        for (const auto& item : world.warframes) add(item.id);
+        for (const auto& entry : world.weapons) add(entry["uniqueName"].get<std::string>());
+        for (const auto& entry : world.sentinels) add(entry["uniqueName"].get<std::string>());
+        for (const auto& item : world.resources) add(item.id);
+        for (const auto& recipe : world.recipes) add(recipe.blueprint);
+        for (const auto& relic : world.relics) {
+            for (const char* variant : {"Bronze", "Silver", "Gold", "Platinum"}) add(relic.base + variant);
+        }
+        for (const auto& arcane : world.arcanes) add(arcane.item.id);
+        for (const auto& mod : world.mods) add(mod.item.id);
+        out.end();
+    }
+}
+
+void WritePlayer(const World& world, const std::filesystem::path& path, int inventory, std::mt19937& rng) {
+    std::uniform_int_distribution<int> count(0, 5);
+    std::uniform_int_distribution<int> xp(0, 2'000'000);
+    ExportWriter out(path);
+    out.value("PlayerLevel", 25);
+
+    out.begin("Recipes");
+    for (int round = 0; round < inventory; ++round) {
+        for (size_t i = 0; i < world.recipes.size(); i += 3) {
+            out.add({{"ItemType", world.recipes[i].blueprint}, {"ItemCount", count(rng)}});
+        }
+    }
+    out.end();
+
+    out.begin("MiscItems");
+    for (int round = 0; round < inventory; ++round) {
+        for (const auto& item : world.resources) {
+            out.add({{"ItemType", item.id}, {"ItemCount", count(rng) * 100}});
+        }
+        for (size_t i = 0; i < world.relics.size(); i += 2) {
+            for (const char* variant : {"Bronze", "Silver", "Gold", "Platinum"}) {
+                out.add({{"ItemType", world.relics[i].base + variant}, {"ItemCount", count(rng)}});
+            }
+        }
+    }
+    out.end();
+
+    out.begin("RawUpgrades");
+    for (int round = 0; round < inventory; ++round) {
+        for (size_t i = 0; i < world.mods.size(); i += 2) {
+            out.add({{"ItemType", world.mods[i].item.id}, {"ItemCount", count(rng)}, {"LastAdded", {{"$oid", "0"}}}});
+        }
+    }
+    out.end();
+
+    out.begin("Upgrades");
+    size_t oid = 0;
+    auto upgrade = [&](const std::string& type, const std::string& fingerprint) {
+        char buffer[25];
+        std::snprintf(buffer, sizeof(buffer), "%024zx", oid++);
+        out.add({{"UpgradeFingerprint", fingerprint}, {"ItemType", type}, {"ItemId", {{"$oid", buffer}}}});
+    };
+    for (int round = 0; round < inventory; ++round) {
+        for (size_t i = 0; i < world.mods.size(); ++i) {
+            const auto& mod = world.mods[i];
+            if (mod.item.id.find("/Randomized/") != std::string::npos) {
+                upgrade(mod.item.id, R"({"compat":"/Lotus/Weapons/Tenno/LongGuns/Synth0/Synth0","lim":0,"lvlReq":10,"pol":"AP_ATTACK","buffs":[{"Tag":"WeaponCritChanceMod","Value":120}],"curses":[],"lvl":8})");
+            } else if (i % 3 == 0) {
+                upgrade(mod.item.id, R"({"lvl":)" + Num(static_cast<int>(i % (mod.fusionLimit + 1))) + "}");
+            }
+        }
+        for (size_t i = 0; i < world.arcanes.size(); i += 2) {
+            upgrade(world.arcanes[i].item.id, R"({"lvl":)" + Num(static_cast<int>(i % 6)) + "}");
+        }
+        upgrade("/Lotus/Upgrades/Mods/Rifle/SynthMod0", "not json"); //broken fingerprints exist in the wild too
+    }
+    out.end();
+
+    out.begin("XPInfo");
+    for (int round = 0; round < inventory; ++round) {
+        for (const auto& id : world.masteryItems) {
+            out.add({{"ItemType", id}, {"XP", xp(rng)}});
+        }
+        //owned but missing from the exports, ends up in extraSpecialXp
+        out.add({{"ItemType", "/Lotus/Types/Game/CrewShip/RailJack/SynthHarness"}, {"XP", 1'600'000}});
+    }
+    out.end();
+
+    out.begin("Missions");
+    for (size_t i = 0; i < world.regions.size(); ++i) {
+        if (i % 4 == 3) continue;
+        out.add({{"Tag", world.regions[i].id}, {"Completes", static_cast<int>(i % 7)}, {"Tier", static_cast<int>(i % 2)}});
+    }
+    for (size_t i = 0; i + 1 < world.systems.size(); ++i) {
+        std::string from = world.systems[i];
+        std::string to = world.systems[i + 1];
+        std::erase(from, ' ');
+        std::erase(to, ' ');
+        out.add({{"Tag", from + "To" + to + "Junction"}, {"Completes", 1}});
+    }
+    out.end();
+
+    //order matters, the LPP_ keys start a category
+    out.value("PlayerSkills", json::parse(R"({"LPP_SPACE":10,"LPS_PILOTING":7,"LPS_GUNNERY":10,"LPS_TACTICAL":3,)"
+                                          R"("LPS_ENGINEERING":9,"LPS_COMMAND":2,"LPP_DRIFTER":10,"LPS_DRIFT_RIDING":6,)"
+                                          R"("LPS_DRIFT_COMBAT":5,"LPS_DRIFT_OPPORTUNITY":1,"LPS_DRIFT_ENDURANCE":8})"));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path outDir = "synthetic-data";
+    int scale = 1;
+    int inventory = 1;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (arg == "--scale" && i + 1 < argc) {
+            scale = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--inventory" && i + 1 < argc) {
+            inventory = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--out dir] [--scale n] [--inventory n] [--seed n]\n";
+            return 2;
+        }
+    }
+
+    World world;
+    AddWorld(world, scale);
+    AddWarframes(world, scale);
+    AddWeapons(world, scale);
+    AddSentinels(world, scale);
+    AddMods(world, scale);
+    AddRelics(world, scale); //rewards are drawn from the prime parts and mods above
+    AddArcanes(world, scale);
+
+    std::error_code ec;
+    std::filesystem::create_directories(outDir / "Warframe", ec);
+    std::filesystem::create_directories(outDir / "Player", ec);
+    if (ec) {
+        std::cerr << "could not create " << outDir << ": " << ec.message() << "\n";
+        return 1;
+    }
+
+    std::mt19937 rng(seed);
+    WriteExports(world, outDir / "Warframe");
+    WritePlayer(world, outDir / "Player" / "player_data.json", inventory, rng);
+
+    std::cout << "wrote " << world.warframes.size() << " warframes, " << world.weapons.size() << " weapons, "
+              << world.recipes.size() << " recipes, " << world.relics.size() * 4 << " relics, "
+              << world.arcanes.size() << " arcanes, " << world.mods.size() << " mods to " << outDir << "\n";
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Runs the game update against bench/updateStub.py instead of DE's servers and checks what it leaves on disk.
+// Goes through a first full download, an update with nothing changed, an update where one download fails,
+// an update where replacing one export fails, and a recovered update; prints one line per case with the
+// time taken and the connections the stub saw, and exits non-zero if any case did not end as it should.
+//
+// Everything happens in a fresh temporary directory laid out like the app's ('run/' next to 'data/'),
+// nothing in the repository's data/ is touched.
+//
+// The export urls are fixed in apiParser.cpp, so build against a copy pointing at the stub, from the
+// repository root, e.g.
+//   sed 's#https://[a-z]*\.warframe\.com#http://127.0.0.1:8765#' src/apiParser/apiParser.cpp > /tmp/apiParserStub.cpp
+//   g++ -std=c++20 -O2 -Isrc -Isrc/apiParser bench/updateBench.cpp /tmp/apiParserStub.cpp src/FileAccess/*.cpp
+//       -lcurl -llzma -lpthread
+// and start the stub first:
+//   python3 bench/updateStub.py --exports 20 --delay 0.3
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+
+#include "apiParser/apiParser.h"
+
+namespace {
+
+const std::string stubUrl = "http://127.0.0.1:8765";
+const std::filesystem::path exportDir = "../data/Warframe";
+
+void Control(const std::string& command) {
+    fetchUrl(stubUrl + "/control/" + command, FetchType::STRING);
+}
+
+//0 if the stub does not answer, otherwise it has at least seen the connection asking
+size_t Connections() {
+    const std::vector<uint8_t> body = fetchUrl(stubUrl + "/control/connections", FetchType::STRING);
+    const std::string text(body.begin(), body.end());
+    return !text.empty() && text.find_first_not_of("0123456789") == std::string::npos ? std::stoul(text) : 0;
+}
+
+//every file in the export directory with its content, the index and leftovers included
+std::map<std::string, std::string> Exports() {
+    std::map<std::string, std::string> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(exportDir, ec)) {
+        if (!entry.is_regular_file()) continue;
+        std::ifstream file(entry.path(), std::ios::binary);
+        files[entry.path().filename().string()] = std::string(std::istreambuf_iterator<char>(file), {});
+    }
+    return files;
+}
+
+bool Run(const char* name, bool expectSuccess, size_t expectChanged, bool expectUnchangedFiles) {
+    const std::map<std::string, std::string> before = Exports();
+    const size_t connectionsBefore = Connections();
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t progressCalls = 0;
+    const GameUpdateResult result = FetchGameUpdate([&](size_t, size_t) { ++progressCalls; });
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    const std::map<std::string, std::string> after = Exports();
+    bool ok = result.success == expectSuccess && result.changed.size() == expectChanged;
+    if (expectUnchangedFiles) ok = ok && before == after;
+    for (const auto& [file, content] : after) {
+        if (file.ends_with(".part") || file.ends_with(".old")) ok = false; //staging and backups are always cleaned up
+    }
+
+    //new connections the update opened; the control requests mostly reuse a pooled one
+    std::cout << (ok ? "ok   " : "FAIL ") << name << ": success=" << result.success << " changed=" << result.changed.size()
+              << " progress=" << progressCalls << " files=" << after.size() << " ms=" << ms
+              << " connections=" << Connections() - connectionsBefore << "\n";
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    if (Connections() == 0) {
+        std::cerr << "no stub at " << stubUrl << ", start bench/updateStub.py first\n";
+        return 1;
+    }
+
+    const std::filesystem::path root = std::filesystem::temp_directory_path() /
+        ("updateBench-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(root / "run");
+    std::filesystem::create_directories(root / "data" / "Log");
+    std::filesystem::current_path(root / "run");
+
+    bool ok = true;
+    ok &= Run("first download", true, 1, false); //only ExportWeapons maps to a DataType
+    ok &= Run("nothing changed", true, 0, true);
+
+    Control("bump");
+    Control("fail/Export07_en.json");
+    ok &= Run("one download fails", false, 0, true);
+    Control("heal");
+
+    //a non-empty directory where the backup goes makes moving that export aside fail, after the ones before it were replaced
+    std::filesystem::create_directories(exportDir / "Export10_en.json.old" / "blocker");
+    ok &= Run("one replace fails", false, 0, true);
+    std::filesystem::remove_all(exportDir / "Export10_en.json.old");
+
+    ok &= Run("recovered", true, 1, false);
+
+    std::filesystem::current_path(root.parent_path());
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+# Stand-in for DE's PublicExport servers, for updateBench.cpp.
+# Serves index_en.txt.lzma and the manifest files for a made up set of exports over keep-alive HTTP/1.1,
+# every manifest file after a delay like a real download. Counts the connections it accepted.
+#
+#   python3 bench/updateStub.py [--port 8765] [--exports 20] [--delay 0.3]
+#
+# Control requests, so a driver can walk through the update cases without restarting it:
+#   /control/bump          new version suffix for every export, the next update has to fetch all of them
+#   /control/fail/<file>   requests for that export answer 500 from now on
+#   /control/heal          no more failures
+#   /control/connections   connections accepted so far, as plain text
+
+import argparse
+import http.server
+import lzma
+import threading
+import time
+
+
+class Stub:
+    def __init__(self, exports, delay):
+        # a real export name among them, so FetchGameUpdate has a DataType to invalidate
+        self.files = ["ExportWeapons_en.json"] + ["Export%02d_en.json" % i for i in range(exports - 1)]
+        self.delay = delay
+        self.version = 0
+        self.failing = set()
+        self.connections = 0
+        self.lock = threading.Lock()
+
+    def suffix(self):
+        return "!00_" + ("%022d" % self.version)
+
+    def index(self):
+        lines = "".join(name + self.suffix() + "\r\n" for name in self.files)
+        return lzma.compress(lines.encode(), format=lzma.FORMAT_ALONE)
+
+    def export(self, line):
+        for name in self.files:
+            if line == name + self.suffix():
+                return name
+        return None
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    stub = None
+
+    def setup(self):
+        super().setup()
+        with self.stub.lock:
+            self.stub.connections += 1
+
+    def reply(self, status, body=b""):
+        self.send_response(status)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_GET(self):
+        stub = self.stub
+        path = self.path
+        if path.startswith("/control/"):
+            with stub.lock:
+                if path == "/control/bump":
+                    stub.version += 1
+                elif path.startswith("/control/fail/"):
+                    stub.failing.add(path[len("/control/fail/"):])
+                elif path == "/control/heal":
+                    stub.failing.clear()
+                elif path == "/control/connections":
+                    return self.reply(200, str(stub.connections).encode())
+                else:
+                    return self.reply(404)
+            return self.reply(200, b"ok")
+
+        if path == "/PublicExport/index_en.txt.lzma":
+            with stub.lock:
+                body = stub.index()
+            return self.reply(200, body)
+
+        prefix = "/PublicExport/Manifest/"
+        if path.startswith(prefix):
+            time.sleep(stub.delay)
+            with stub.lock:
+                name = stub.export(path[len(prefix):])
+                failing = name in stub.failing
+                version = stub.version
+            if name is None:
+                return self.reply(404)
+            if failing:
+                return self.reply(500)
+            return self.reply(200, ('{"stub":"%s","version":%d}' % (name, version)).encode())
+
+        self.reply(404)
+
+    def log_message(self, *args):
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--exports", type=int, default=20)
+    parser.add_argument("--delay", type=float, default=0.3, help="seconds per manifest file")
+    args = parser.parse_args()
+
+    Handler.stub = Stub(args.exports, args.delay)
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+    print("serving %d exports on http://127.0.0.1:%d" % (args.exports, args.port), flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -1,12 +1,18 @@
 #include "FileAccess.h"
 
+#include <condition_variable>
+#include <exception>
 #include <fstream>
 #include <ios>
 #include <iosfwd>
 #include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 
 #include "apiParser/apiParser.h"
+#include "imageCache.h"
 
 bool SaveDataAt(const std::string& data, const std::string& path, const std::ios_base::openmode mode) {
     std::ofstream outfile(path, mode);
@@ -18,12 +24,168 @@ bool SaveDataAt(const std::string& data, const std::string& path, const std::ios
     return true;
 }
 
-//locking LogThis() to make sure it can be called from background thread safely
-std::mutex logMutex;
+namespace {
+
+//callers only append to 'pending' under the lock, the writer thread swaps the whole batch out and
+//writes it without holding the lock, so LogThis() never waits on the disk. Whoever writes to 'file' holds
+//fileMutex; it is never waited for while holding 'mutex' except once the writer thread is gone
+class LogSink {
+public:
+    LogSink() {
+        //the log only covers the current run
+        file.open(logPath, std::ios::out | std::ios::trunc);
+        writer = std::thread([this] { run(); });
+    }
+
+    ~LogSink() {
+        shutdown();
+    }
+
+    void push(std::string line) {
+        {
+            std::lock_guard lock(mutex);
+            if (stopped) {
+                //writer is gone (static destruction or after ShutdownLog), write directly instead
+                std::lock_guard fileLock(fileMutex);
+                writeLine(line);
+                file.flush();
+                return;
+            }
+            pending.push_back(std::move(line));
+        }
+        wake.notify_one();
+    }
+
+    void flush() {
+        std::unique_lock lock(mutex);
+        if (stopped) return;
+        const uint64_t target = queued();
+        wake.notify_one();
+        written.wait(lock, [&] { return writtenCount >= target || stopped; });
+    }
+
+    void shutdown() {
+        {
+            std::lock_guard lock(mutex);
+            if (stopped) return;
+            stopping = true;
+        }
+        wake.notify_one();
+        if (writer.joinable()) writer.join();
+    }
+
+    //last resort from the terminate handler; the writer thread may be stuck or dead, so write what is
+    //still queued from the calling thread. try_lock because the crash might have happened while holding
+    //either lock; if the writer is in the middle of a batch the file is its, and the rest stays unwritten
+    void emergencyFlush() {
+        std::unique_lock lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) return;
+        std::unique_lock fileLock(fileMutex, std::try_to_lock);
+        if (!fileLock.owns_lock()) return;
+        for (const auto& line : pending) writeLine(line);
+        pending.clear();
+        file.flush();
+    }
+
+private:
+    uint64_t queued() const {
+        return writtenCount + inFlight + pending.size();
+    }
+
+    void writeLine(const std::string& line) {
+        file << line << '\n';
+    }
+
+    void run() {
+        std::vector<std::string> batch;
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return !pending.empty() || stopping; });
+            if (pending.empty() && stopping) break;
+
+            batch.swap(pending);
+            inFlight = batch.size();
+            lock.unlock();
+            {
+                std::lock_guard fileLock(fileMutex);
+                for (const auto& line : batch) writeLine(line);
+                file.flush();
+            }
+            batch.clear();
+            lock.lock();
+
+            writtenCount += inFlight;
+            inFlight = 0;
+            written.notify_all();
+        }
+        stopped = true;
+        written.notify_all();
+    }
+
+    std::ofstream file;
+    std::mutex fileMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    std::vector<std::string> pending;
+    uint64_t writtenCount = 0;
+    size_t inFlight = 0;
+    bool stopping = false;
+    bool stopped = false;
+    std::thread writer;
+};
+
+std::terminate_handler previousTerminate = nullptr;
+
+//the terminate handler writes out what is still queued; fatal signals (a segfault, abort() from
+//elsewhere) are not covered, whatever was queued at that point is lost
+LogSink& Sink() {
+    static LogSink sink;
+    static const bool handlerInstalled = [] {
+        previousTerminate = std::set_terminate([] {
+            Sink().emergencyFlush();
+            if (previousTerminate) previousTerminate();
+            std::abort();
+        });
+        return true;
+    }();
+    (void)handlerInstalled;
+    return sink;
+}
+
+std::string_view LevelPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "[debug] ";
+        case LogLevel::Warning: return "[warning] ";
+        case LogLevel::Error:   return "[error] ";
+        default:                return "";
+    }
+}
+
+} // namespace
+
+void SetLogLevel(LogLevel level) {
+    currentLogLevel.store(level, std::memory_order_relaxed);
+}
+
+void QueueLogLine(LogLevel level, std::string line) {
+    if (const auto prefix = LevelPrefix(level); !prefix.empty()) {
+        line.insert(0, prefix);
+    }
+    Sink().push(std::move(line));
+}
+
+void FlushLog() {
+    Sink().flush();
+}
+
+void ShutdownLog() {
+    Sink().shutdown();
+}
 
 void LogThis(const std::string& str) {
-    std::lock_guard lock(logMutex);
-    SaveDataAt(str + "\n", logPath, std::ios::out | std::ios::app);
+    if (!LogEnabled(LogLevel::Info)) return;
+    Sink().push(str);
 }
 
 std::string ReadFile(const std::string& path) {
@@ -37,47 +199,22 @@ std::string ReadFile(const std::string& path) {
     return content;
 }
 
-// Converts std::string to shared_ptr<const std::vector<uint8_t>>
-std::shared_ptr<const std::vector<uint8_t>> MakeByteVector(const std::string& data) {
-    return std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
-}
-
-// Helper to sanitize filename (remove everything after '!' if present)
-std::string SanitizeFilename(const std::string& image) {
-    size_t excl = image.find('!');
-    std::string result = (excl != std::string::npos) ? image.substr(0, excl) : image;
-
-    std::string replacement = "_"; //because we cant save images like this
-    size_t pos = 0;
-    while ((pos = result.find('/', pos)) != std::string::npos) {
-        result.replace(pos, 1, replacement);
-        pos += replacement.length();
-    }
-
-    return result;
-}
-
-
+// Memory first, then the disk cache in Download/images, then the network. The disk index decides a miss,
+// so images that were never stored cost no file access.
 std::shared_ptr<const std::vector<uint8_t>> GetImageByFileOrDownload(const std::string& image) {
-    std::string sanitized = SanitizeFilename(image);
-    std::string fullPath = downloadPath + sanitized;
-
-    // Try loading from disk
-    std::string fileData = ReadFile(fullPath);
-    if (!fileData.empty()) {
-        return MakeByteVector(fileData);
+    if (auto cached = ImageMemoryCache().get(image)) {
+        return cached;
+    }
+    if (auto stored = ImageDiskCache().get(image)) {
+        ImageMemoryCache().put(image, stored);
+        return stored;
     }
 
-    // File not found locally, attempt download
     auto downloaded = fetchUrlCached(image, FetchType::PNG);
-    if (downloaded && !downloaded->empty()) {
-        // Save downloaded data to disk
-        std::string dataStr(downloaded->begin(), downloaded->end());
-        if (!SaveDataAt(dataStr, fullPath, std::ios::binary)) {
-            LogThis("Failed to save downloaded image to " + fullPath);
-        }
+    //the fallback stands in for a failed download, keeping it would hide the real image for good
+    if (downloaded && !downloaded->empty() && downloaded != getFallbackDefaultPng()) {
+        ImageDiskCache().put(image, *downloaded);
     }
-
     return downloaded;
 }
 
@@ -129,6 +266,7 @@ Settings LoadSettings() {
         if (key == "fullItems") settings.fullItems = (value == "true" || value == "1");
         else if (key == "hideFounder") settings.hideFounder = (value == "true" || value == "1");
         else if (key == "saveDownload") settings.saveDownload = (value == "true" || value == "1");
+        else if (key == "compactImages") settings.compactImages = (value == "true" || value == "1");
         else if (key == "authTokenGetterRead") settings.authTokenGetterRead = (value == "true" || value == "1");
         else if (key == "startWithSystem") settings.startWithSystem = (value == "true" || value == "1");
         else if (key == "autoSync") settings.autoSync = (value == "true" || value == "1");
@@ -147,6 +285,7 @@ void WriteSettings(const Settings& settings) {
     data += "fullItems=" + std::string(settings.fullItems ? "true" : "false") + "\n";
     data += "hideFounder=" + std::string(settings.hideFounder ? "true" : "false") + "\n";
     data += "saveDownload=" + std::string(settings.saveDownload ? "true" : "false") + "\n";
+    data += "compactImages=" + std::string(settings.compactImages ? "true" : "false") + "\n";
     data += "authTokenGetterRead=" + std::string(settings.authTokenGetterRead ? "true" : "false") + "\n";
     data += "startWithSystem=" + std::string(settings.startWithSystem ? "true" : "false") + "\n";
     data += "autoSync=" + std::string(settings.autoSync ? "true" : "false") + "\n";
@@ -163,42 +302,95 @@ bool SettingsFileExists() {
     return file.good();
 }
 
-template<typename FileJsonType = nlohmann::json>
-FileJsonType ReadData(DataType type) {
-    std::string filename;
+std::string PathFromDataType(DataType type) {
     switch (type) {
-        case DataType::Warframes:       filename = "../data/Warframe/ExportWarframes_en.json"; break;
-        case DataType::Blueprints:      filename = "../data/Warframe/ExportRecipes_en.json"; break;
-        case DataType::Customs:         filename = "../data/Warframe/ExportCustoms_en.json"; break;
-        case DataType::Drones:          filename = "../data/Warframe/ExportDrones_en.json"; break;
-        case DataType::Flavour:         filename = "../data/Warframe/ExportFlavour_en.json"; break;
-        case DataType::FusionsBundles:  filename = "../data/Warframe/ExportFusionBundles_en.json"; break;
-        case DataType::Gear:            filename = "../data/Warframe/ExportGear_en.json"; break;
-        case DataType::Keys:            filename = "../data/Warframe/ExportKeys_en.json"; break;
-        case DataType::Images:           filename = "../data/Warframe/ExportManifest.json"; break;
-        case DataType::Mods:            filename = "../data/Warframe/ExportUpgrades_en.json"; break;
-        case DataType::Regions:         filename = "../data/Warframe/ExportRegions_en.json"; break;
-        case DataType::Resources:       filename = "../data/Warframe/ExportResources_en.json"; break;
-        case DataType::Sentinels:       filename = "../data/Warframe/ExportSentinels_en.json"; break;
-        case DataType::SortieRewards:   filename = "../data/Warframe/ExportSortieRewards_en.json"; break;
-        case DataType::Relics:          filename = "../data/Warframe/ExportRelicArcane_en.json"; break;
-        case DataType::Weapons:         filename = "../data/Warframe/ExportWeapons_en.json"; break;
-        case DataType::Player:         filename = "../data/Player/player_data.json"; break;
-        case DataType::Nodes:         filename = "../data/Warframe/XpValues.json"; break;
+        case DataType::Warframes:       return "../data/Warframe/ExportWarframes_en.json";
+        case DataType::Blueprints:      return "../data/Warframe/ExportRecipes_en.json";
+        case DataType::Customs:         return "../data/Warframe/ExportCustoms_en.json";
+        case DataType::Drones:          return "../data/Warframe/ExportDrones_en.json";
+        case DataType::Flavour:         return "../data/Warframe/ExportFlavour_en.json";
+        case DataType::FusionsBundles:  return "../data/Warframe/ExportFusionBundles_en.json";
+        case DataType::Gear:            return "../data/Warframe/ExportGear_en.json";
+        case DataType::Keys:            return "../data/Warframe/ExportKeys_en.json";
+        case DataType::Images:          return "../data/Warframe/ExportManifest.json";
+        case DataType::Mods:            return "../data/Warframe/ExportUpgrades_en.json";
+        case DataType::Regions:         return "../data/Warframe/ExportRegions_en.json";
+        case DataType::Resources:       return "../data/Warframe/ExportResources_en.json";
+        case DataType::Sentinels:       return "../data/Warframe/ExportSentinels_en.json";
+        case DataType::SortieRewards:   return "../data/Warframe/ExportSortieRewards_en.json";
+        case DataType::Relics:          return "../data/Warframe/ExportRelicArcane_en.json";
+        case DataType::Weapons:         return "../data/Warframe/ExportWeapons_en.json";
+        case DataType::Player:          return "../data/Player/player_data.json";
+        case DataType::Nodes:           return "../data/Warframe/XpValues.json";
         default: throw std::runtime_error("Unimplemented DataType!");
     }
-    LogThis("reading data type: " + std::to_string(static_cast<int>(type)));
-    return FileJsonType::parse(ReadFile(filename));
 }
 
-template nlohmann::json ReadData<nlohmann::json>(DataType);
-template nlohmann::ordered_json ReadData<nlohmann::ordered_json>(DataType);
+std::optional<DataType> DataTypeFromExportFile(const std::string& fileName) {
+    for (int i = 0; i <= static_cast<int>(DataType::Nodes); ++i) {
+        const auto type = static_cast<DataType>(i);
+        const std::string path = PathFromDataType(type);
+        if (path.size() > fileName.size() && path.ends_with("/" + fileName)) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+//parse-once cache for ReadData; a file is only parsed again after InvalidateData() dropped it
+std::mutex dataCacheMutex;
+std::unordered_map<DataType, std::shared_ptr<const nlohmann::json>> dataCache;
+std::unordered_map<DataType, std::shared_ptr<const nlohmann::ordered_json>> orderedDataCache;
+std::unordered_map<DataType, uint64_t> dataGenerations; //bumped by InvalidateData, tells a parse that its file was replaced meanwhile
+
+template<typename FileJsonType>
+std::unordered_map<DataType, std::shared_ptr<const FileJsonType>>& DataCacheFor() {
+    if constexpr (std::is_same_v<FileJsonType, nlohmann::ordered_json>) {
+        return orderedDataCache;
+    } else {
+        return dataCache;
+    }
+}
+
+template<typename FileJsonType = nlohmann::json>
+std::shared_ptr<const FileJsonType> ReadData(DataType type) {
+    auto& cache = DataCacheFor<FileJsonType>();
+    uint64_t generation;
+    {
+        std::lock_guard lock(dataCacheMutex);
+        if (auto it = cache.find(type); it != cache.end()) {
+            return it->second;
+        }
+        generation = dataGenerations[type];
+    }
+
+    //parsing outside the lock so a big player file does not block readers of other exports
+    LogThis(LogLevel::Debug, "reading data type: ", static_cast<int>(type));
+    auto parsed = std::make_shared<const FileJsonType>(FileJsonType::parse(ReadFile(PathFromDataType(type))));
+
+    std::lock_guard lock(dataCacheMutex);
+    if (dataGenerations[type] != generation) {
+        return parsed; //the file got replaced while we parsed, this version may be the old one and must not stay cached
+    }
+    auto [it, inserted] = cache.try_emplace(type, std::move(parsed));
+    return it->second; //if another thread was faster we hand out its version instead
+}
+
+template std::shared_ptr<const nlohmann::json> ReadData<nlohmann::json>(DataType);
+template std::shared_ptr<const nlohmann::ordered_json> ReadData<nlohmann::ordered_json>(DataType);
 
 // concrete overloads that simply call the instantiated template
-nlohmann::json ReadData(DataType type) {
+std::shared_ptr<const nlohmann::json> ReadData(DataType type) {
     return ReadData<nlohmann::json>(type);
 }
 
-nlohmann::ordered_json ReadDataOrdered(DataType type) {
+std::shared_ptr<const nlohmann::ordered_json> ReadDataOrdered(DataType type) {
     return ReadData<nlohmann::ordered_json>(type);
-}
\ No newline at end of file
+}
+
+void InvalidateData(DataType type) {
+    std::lock_guard lock(dataCacheMutex);
+    dataCache.erase(type);
+    orderedDataCache.erase(type);
+    ++dataGenerations[type];
+}
@@ -1,7 +1,12 @@
 #ifndef FILEACCESS_H
 #define FILEACCESS_H
+#include <atomic>
 #include <ios>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <nlohmann/json.hpp>
 
 enum class DataType {
@@ -29,6 +34,7 @@ struct Settings {
     bool fullItems = true;
     bool hideFounder = true;
     bool saveDownload = false;
+    bool compactImages = false; //re-encode saved pictures as lossy WebP, smaller but no longer the original files
     bool authTokenGetterRead = false;
     bool startWithSystem = false;
     bool autoSync = false;
@@ -40,14 +46,60 @@ struct Settings {
 static const std::string logPath = "../data/Log/Log.txt";
 static const std::string settingPath = "../data/Settings/Settings.cfg";
 static const std::string downloadPath = "../data/Download/";
-void LogThis(const std::string& str);
+static const std::string cachePath = "../data/Cache/";
+
+// Log lines are queued and written in batches by a background thread that keeps the log file open.
+// Anything below the current level is dropped before the line is even built.
+enum class LogLevel {
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+inline std::atomic<LogLevel> currentLogLevel{LogLevel::Info};
+
+inline bool LogEnabled(LogLevel level) {
+    return level >= currentLogLevel.load(std::memory_order_relaxed);
+}
+
+void SetLogLevel(LogLevel level);
+void QueueLogLine(LogLevel level, std::string line);
+void FlushLog(); //blocks until every queued line is on disk
+void ShutdownLog(); //flushes and stops the writer thread, later lines are written directly
+
+void LogThis(const std::string& str); //Info level
+
+inline void AppendLogPart(std::string& line, std::string_view part) {
+    line.append(part);
+}
+
+template<typename T> requires std::is_arithmetic_v<T>
+void AppendLogPart(std::string& line, T part) {
+    line.append(std::to_string(part));
+}
+
+//LogThis(LogLevel::Debug, "fetched ", url, " got size ", size); only concatenates if the level is enabled
+template<typename... Parts>
+void LogThis(LogLevel level, const Parts&... parts) {
+    if (!LogEnabled(level)) return;
+    std::string line;
+    (AppendLogPart(line, parts), ...);
+    QueueLogLine(level, std::move(line));
+}
+
 bool SaveDataAt(const std::string& data, const std::string& path, std::ios_base::openmode mode = std::ios::out);
 std::shared_ptr<const std::vector<uint8_t>> GetImageByFileOrDownload(const std::string& image);
 Settings LoadSettings();
 void WriteSettings(const Settings& settings);
 bool SettingsFileExists();
 
-nlohmann::json ReadData(DataType type);
-nlohmann::ordered_json ReadDataOrdered(DataType type);
+std::string PathFromDataType(DataType type);
+std::optional<DataType> DataTypeFromExportFile(const std::string& fileName); //'ExportWeapons_en.json' -> Weapons
+
+// Parsed once and shared until invalidated; the returned json must not be modified
+std::shared_ptr<const nlohmann::json> ReadData(DataType type);
+std::shared_ptr<const nlohmann::ordered_json> ReadDataOrdered(DataType type);
+void InvalidateData(DataType type); //used after a file got downloaded again
 
 #endif //FILEACCESS_H
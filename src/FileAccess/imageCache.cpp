@@ -0,0 +1,331 @@
+#include "imageCache.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+#include "FileAccess.h"
+
+namespace {
+
+constexpr const char* indexName = "index.txt";
+constexpr const char* indexHeader = "AWPI 1";
+constexpr size_t changesPerIndexWrite = 16; //the index is rewritten as a whole, so batch it a little
+
+uint64_t Fnv1a(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string Hex(uint64_t value) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+    return buffer;
+}
+
+//urls contain '/', '!' and can be long; the file name only has to be unique per key
+std::string FileNameOf(const std::string& key) {
+    return Hex(Fnv1a(reinterpret_cast<const uint8_t*>(key.data()), key.size())) + ".img";
+}
+
+//older versions saved every image straight into downloadPath, named after its texture path with '/' turned
+//into '_' and the '!' suffix cut off. That cannot be turned back into a cache key, so those files are only
+//deleted; nothing else writes files there. Once they are gone this is a listing of a single directory.
+void RemoveFlatDownloads() {
+    std::error_code ec;
+    size_t removed = 0;
+    for (const auto& file : std::filesystem::directory_iterator(downloadPath, ec)) {
+        if (!file.is_regular_file(ec) || !file.path().filename().string().starts_with("_")) continue;
+        if (std::filesystem::remove(file.path(), ec)) ++removed;
+    }
+    if (removed > 0) {
+        LogThis("Removed " + std::to_string(removed) + " images saved outside the image cache by an older version");
+    }
+}
+
+} // namespace
+
+// ---------- memory ----------
+
+ImageBytes MemoryImageCache::get(const std::string& key) {
+    std::lock_guard lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) return nullptr;
+    order.splice(order.begin(), order, it->second.order);
+    return it->second.data;
+}
+
+void MemoryImageCache::put(const std::string& key, ImageBytes data) {
+    if (!data || data->size() > budget) return;
+
+    std::lock_guard lock(mutex);
+    if (auto it = entries.find(key); it != entries.end()) {
+        used -= it->second.data->size();
+        order.erase(it->second.order);
+        entries.erase(it);
+    }
+
+    used += data->size();
+    order.push_front(key);
+    entries.emplace(key, Entry{std::move(data), order.begin()});
+
+    while (used > budget) {
+        auto victim = entries.find(order.back());
+        used -= victim->second.data->size();
+        entries.erase(victim);
+        order.pop_back();
+    }
+}
+
+// ---------- disk ----------
+
+DiskImageCache::DiskImageCache(std::string directory, uintmax_t budgetBytes)
+    : directory(std::move(directory)), budget(budgetBytes) {
+    load();
+}
+
+DiskImageCache::~DiskImageCache() {
+    stopTranscoding();
+}
+
+void DiskImageCache::load() {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    std::ifstream index(directory + indexName);
+    std::string line;
+    if (index.is_open() && std::getline(index, line) && line == indexHeader) {
+        while (std::getline(index, line)) {
+            std::istringstream fields(line);
+            Entry entry;
+            std::string key;
+            fields >> entry.file >> entry.size >> std::hex >> entry.hash;
+            fields.get(); //the space before the key, which may itself contain anything but a newline
+            std::getline(fields, key);
+            if (!fields && !fields.eof()) continue;
+            if (entry.file.empty() || key.empty() || entries.contains(key)) continue;
+
+            order.push_back(key);
+            entry.order = std::prev(order.end());
+            used += entry.size;
+            entries.emplace(std::move(key), std::move(entry));
+        }
+    } else if (index.is_open()) {
+        LogThis(LogLevel::Warning, "Image cache index has an unknown format, starting empty");
+    }
+
+    //files the index does not know about (crash before the index was written, old .tmp files) would
+    //count against the disk but never get evicted; one directory listing here keeps that in check
+    std::unordered_set<std::string> known;
+    for (const auto& [key, entry] : entries) known.insert(entry.file);
+    for (const auto& file : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = file.path().filename().string();
+        if (name == indexName || known.contains(name)) continue;
+        std::filesystem::remove(file.path(), ec);
+    }
+
+    while (used > budget && !order.empty()) {
+        std::filesystem::remove(directory + entries.at(order.back()).file, ec);
+        removeLocked(order.back());
+        ++unsavedChanges;
+    }
+    LogThis("Image cache holds " + std::to_string(entries.size()) + " images, " + std::to_string(used / 1024) + " KiB");
+}
+
+ImageBytes DiskImageCache::get(const std::string& key) {
+    Entry entry;
+    {
+        std::lock_guard lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end()) return nullptr;
+        order.splice(order.begin(), order, it->second.order);
+        orderChanged = true;
+        entry = it->second;
+    }
+
+    //read outside the lock, other threads keep looking up and storing meanwhile
+    const std::string path = directory + entry.file;
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<uint8_t> data;
+    bool intact = file.is_open() && static_cast<uintmax_t>(file.tellg()) == entry.size;
+    if (intact) {
+        data.resize(static_cast<size_t>(entry.size));
+        file.seekg(0);
+        intact = static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())));
+    }
+    if (intact && Fnv1a(data.data(), data.size()) == entry.hash) {
+        return std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    }
+
+    LogThis(LogLevel::Warning, "Dropping damaged cached image ", key);
+    std::lock_guard lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second.file == entry.file && it->second.hash == entry.hash) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        removeLocked(key);
+        ++unsavedChanges;
+    }
+    return nullptr;
+}
+
+void DiskImageCache::put(const std::string& key, const std::vector<uint8_t>& data) {
+    if (!store(key, data)) return;
+
+    {
+        std::lock_guard lock(mutex);
+        if (!transcoder || transcodeStopping) return;
+        transcodeQueue.push_back(key);
+    }
+    transcodeWake.notify_one();
+}
+
+bool DiskImageCache::store(const std::string& key, const std::vector<uint8_t>& data) {
+    if (data.empty() || data.size() > budget) return false;
+
+    static std::atomic<uint64_t> tmpCounter{0};
+    const std::string file = FileNameOf(key);
+    const std::string path = directory + file;
+    const std::string tmpPath = path + "." + std::to_string(tmpCounter++) + ".tmp";
+
+    //written next to it first so a reader never sees half an image under the final name
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out) {
+            LogThis(LogLevel::Warning, "Failed to write cached image ", tmpPath);
+            std::error_code ec;
+            out.close();
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        LogThis(LogLevel::Warning, "Failed to store cached image ", path, ": ", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    std::lock_guard lock(mutex);
+    if (entries.contains(key)) removeLocked(key);
+
+    order.push_front(key);
+    used += data.size();
+    entries.emplace(key, Entry{file, data.size(), Fnv1a(data.data(), data.size()), order.begin()});
+
+    while (used > budget && order.size() > 1) {
+        std::filesystem::remove(directory + entries.at(order.back()).file, ec);
+        removeLocked(order.back());
+    }
+
+    if (++unsavedChanges >= changesPerIndexWrite) {
+        saveLocked();
+    }
+    return true;
+}
+
+void DiskImageCache::flush() {
+    std::lock_guard lock(mutex);
+    if (unsavedChanges > 0 || orderChanged) {
+        saveLocked();
+    }
+}
+
+void DiskImageCache::setTranscoder(Transcoder newTranscoder) {
+    std::lock_guard lock(mutex);
+    if (transcodeStopping || transcodeThread.joinable()) return; //set once at startup
+    transcoder = std::move(newTranscoder);
+    transcodeThread = std::thread([this] { runTranscodes(); });
+}
+
+void DiskImageCache::stopTranscoding() {
+    {
+        std::lock_guard lock(mutex);
+        transcodeStopping = true;
+        transcodeQueue.clear();
+    }
+    transcodeWake.notify_one();
+    if (transcodeThread.joinable()) transcodeThread.join();
+}
+
+void DiskImageCache::runTranscodes() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        transcodeWake.wait(lock, [&] { return !transcodeQueue.empty() || transcodeStopping; });
+        if (transcodeStopping) break;
+
+        const std::string key = std::move(transcodeQueue.front());
+        transcodeQueue.pop_front();
+        lock.unlock();
+
+        //read back through get so evicted or damaged entries are skipped
+        if (ImageBytes original = get(key)) {
+            std::vector<uint8_t> compact = transcoder(*original);
+            if (!compact.empty() && compact.size() < original->size()) {
+                LogThis(LogLevel::Debug, "Transcoded cached image ", key, " ", original->size(), " -> ", compact.size());
+                store(key, compact);
+            }
+        }
+        lock.lock();
+    }
+}
+
+//caller holds the lock; only forgets the entry, the file is the caller's business
+void DiskImageCache::removeLocked(const std::string& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) return;
+    used -= it->second.size;
+    order.erase(it->second.order);
+    entries.erase(it);
+}
+
+//caller holds the lock
+void DiskImageCache::saveLocked() {
+    std::string content = std::string(indexHeader) + "\n";
+    for (const std::string& key : order) {
+        const Entry& entry = entries.at(key);
+        content += entry.file + " " + std::to_string(entry.size) + " " + Hex(entry.hash) + " " + key + "\n";
+    }
+
+    const std::string path = directory + indexName;
+    const std::string tmpPath = path + ".tmp";
+    std::error_code ec;
+    if (!SaveDataAt(content, tmpPath, std::ios::out | std::ios::binary)) {
+        LogThis(LogLevel::Warning, "Failed to write image cache index ", tmpPath);
+        return;
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        LogThis(LogLevel::Warning, "Failed to replace image cache index: ", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    unsavedChanges = 0;
+    orderChanged = false;
+}
+
+MemoryImageCache& ImageMemoryCache() {
+    static MemoryImageCache cache(IMAGE_MEMORY_BUDGET);
+    return cache;
+}
+
+DiskImageCache& ImageDiskCache() {
+    [[maybe_unused]] static const bool flatDownloadsRemoved = (RemoveFlatDownloads(), true);
+    static DiskImageCache cache(downloadPath + "images/", IMAGE_DISK_BUDGET);
+    return cache;
+}
+
+void FlushImageCache() {
+    ImageDiskCache().stopTranscoding();
+    ImageDiskCache().flush();
+}
@@ -0,0 +1,98 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using ImageBytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+// budgets of the two process wide caches below
+const size_t IMAGE_MEMORY_BUDGET = 64 * 1024 * 1024;
+const uintmax_t IMAGE_DISK_BUDGET = 512ull * 1024 * 1024;
+
+// Least recently used cache with a budget in bytes instead of entries. Thread safe.
+class MemoryImageCache {
+public:
+    explicit MemoryImageCache(size_t budgetBytes) : budget(budgetBytes) {}
+
+    ImageBytes get(const std::string& key);
+    void put(const std::string& key, ImageBytes data); //data bigger than the whole budget is not kept
+
+private:
+    struct Entry {
+        ImageBytes data;
+        std::list<std::string>::iterator order;
+    };
+
+    std::mutex mutex;
+    std::list<std::string> order; //most recently used first
+    std::unordered_map<std::string, Entry> entries;
+    size_t budget;
+    size_t used = 0;
+};
+
+// Persistent cache in its own directory. An index file keeps every entry's file, size and content hash
+// in least recently used order, so a lookup never touches the disk unless the image is actually there.
+// Reads are checked against the hash and damaged entries are dropped. Once the files exceed the budget
+// the least recently used ones are deleted. Thread safe.
+class DiskImageCache {
+public:
+    // Gets the stored bytes and returns a more compact encoding of them, or nothing to keep them as they are
+    using Transcoder = std::function<std::vector<uint8_t>(const std::vector<uint8_t>&)>;
+
+    DiskImageCache(std::string directory, uintmax_t budgetBytes);
+    ~DiskImageCache();
+
+    ImageBytes get(const std::string& key); //nullptr if not cached or damaged
+    void put(const std::string& key, const std::vector<uint8_t>& data);
+    void flush(); //writes the index if it changed since the last write
+
+    // Optional. Every put is then transcoded on a background thread and replaced if the result is smaller,
+    // so only the disk copy changes and the download path never waits for it.
+    void setTranscoder(Transcoder newTranscoder);
+    void stopTranscoding(); //finishes the current one and drops the rest
+
+private:
+    struct Entry {
+        std::string file;
+        uintmax_t size = 0;
+        uint64_t hash = 0;
+        std::list<std::string>::iterator order;
+    };
+
+    void load();
+    bool store(const std::string& key, const std::vector<uint8_t>& data);
+    void removeLocked(const std::string& key);
+    void saveLocked();
+    void runTranscodes();
+
+    std::mutex mutex;
+    std::string directory;
+    std::list<std::string> order; //most recently used first
+    std::unordered_map<std::string, Entry> entries;
+    uintmax_t budget;
+    uintmax_t used = 0;
+    size_t unsavedChanges = 0;
+    bool orderChanged = false;
+
+    Transcoder transcoder;
+    std::deque<std::string> transcodeQueue; //guarded by mutex like the rest
+    std::condition_variable transcodeWake;
+    bool transcodeStopping = false;
+    std::thread transcodeThread;
+};
+
+MemoryImageCache& ImageMemoryCache();
+DiskImageCache& ImageDiskCache(); //lives in downloadPath/images
+void FlushImageCache(); //call on shutdown so the last use order survives, also stops transcoding
+
+#endif //IMAGECACHE_H
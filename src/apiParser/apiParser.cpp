@@ -1,9 +1,5 @@
 #include "apiParser.h"
 
-#define STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "stb_image.h"
-#include "stb_image_write.h"
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -11,18 +7,114 @@
 #include <vector>
 #include <lzma.h>
 #include <sstream>
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <list>
-#include <shared_mutex>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <nlohmann/json.hpp>
 
 #include "FileAccess/FileAccess.h"
+#include "FileAccess/imageCache.h"
+
+namespace {
+
+// Pool of curl easy handles that share one DNS and TLS session cache. Every handle keeps its own connection
+// cache across leases (curl_easy_reset keeps it), so repeated requests to content.warframe.com reuse open
+// connections instead of doing a new TCP+TLS handshake. The connection cache itself is not shared: libcurl
+// does not support sharing it between threads that transfer at the same time.
+// Safe to use from any thread; every request leases its own handle for the duration of the transfer.
+class HttpClient {
+public:
+    static HttpClient& instance() {
+        static HttpClient client;
+        return client;
+    }
+
+    class Lease {
+    public:
+        Lease(HttpClient& owner, CURL* handle) : owner(owner), handle(handle) {}
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { owner.release(handle); }
 
-//cache stuff; Max is in the header
-std::list<std::string> cache_order;
-std::unordered_map<std::string, std::pair<std::shared_ptr<std::vector<uint8_t>>, std::list<std::string>::iterator>> url_cache;
-std::shared_mutex cache_mutex;
+        [[nodiscard]] CURL* get() const { return handle; }
+
+    private:
+        HttpClient& owner;
+        CURL* handle;
+    };
+
+    //returns a handle with all options reset; nullptr if curl could not create one
+    std::unique_ptr<Lease> acquire() {
+        CURL* handle = nullptr;
+        {
+            std::lock_guard lock(poolMutex);
+            if (!idle.empty()) {
+                handle = idle.back();
+                idle.pop_back();
+            }
+        }
+        if (!handle) {
+            handle = curl_easy_init();
+            if (!handle) return nullptr;
+        }
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+        return std::make_unique<Lease>(*this, handle);
+    }
+
+private:
+    //more idle handles than this are not kept, their connections close with them
+    static constexpr size_t maxIdleHandles = 16;
+
+    HttpClient() {
+        //curl_easy_init() would do this implicitly, but that is not thread safe and we fetch from many threads
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        share = curl_share_init();
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, LockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+
+    ~HttpClient() {
+        for (CURL* handle : idle) curl_easy_cleanup(handle);
+        curl_share_cleanup(share);
+    }
+
+    void release(CURL* handle) {
+        //keeps the handle's open connections, drops url, callbacks and buffers of the last request
+        curl_easy_reset(handle);
+        {
+            std::lock_guard lock(poolMutex);
+            if (idle.size() < maxIdleHandles) {
+                idle.push_back(handle);
+                return;
+            }
+        }
+        curl_easy_cleanup(handle);
+    }
+
+    static void LockShare(CURL*, curl_lock_data data, curl_lock_access, void* userp) {
+        static_cast<HttpClient*>(userp)->shareLocks[data % CURL_LOCK_DATA_LAST].lock();
+    }
+
+    static void UnlockShare(CURL*, curl_lock_data data, void* userp) {
+        static_cast<HttpClient*>(userp)->shareLocks[data % CURL_LOCK_DATA_LAST].unlock();
+    }
+
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> shareLocks;
+    std::mutex poolMutex;
+    std::vector<CURL*> idle;
+};
+
+} // namespace
 
 static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     size_t realSize = size * nmemb;
@@ -112,75 +204,30 @@ std::vector<uint8_t> lzmaDecode(const std::vector<uint8_t>& input, size_t expect
     return output;
 }
 
-//TODO: better caching
+//memory tier of the image cache; the disk tier sits on top of this in GetImageByFileOrDownload
 std::shared_ptr<const std::vector<uint8_t>>  fetchUrlCached(const std::string& url, FetchType fetchType) {
-    //shared Read Lock (allows multiple reads); Update: cant do that because LRU
-    {
-        std::unique_lock read_lock(cache_mutex);
-        auto it = url_cache.find(url);
-        if (it != url_cache.end()) {
-            cache_order.erase(it->second.second);
-            cache_order.push_front(url);
-            it->second.second = cache_order.begin();
-            return it->second.first;
-        }
+    if (auto cached = ImageMemoryCache().get(url)) {
+        return cached;
     }
 
-    // Not cached, so fetch
     std::vector<uint8_t> raw_data = fetchUrl(url, fetchType);
     if (raw_data.empty()) {
         return getFallbackDefaultPng();
     }
-    auto result = std::make_shared<std::vector<uint8_t>>(std::move(raw_data));
-
-    //Locks when writing
-    {
-        std::unique_lock write_lock(cache_mutex);
-        // If cache limit reached, remove least recently used (at the back)
-        if (url_cache.size() >= CACHE_LIMIT) {
-            const std::string& lru_key = cache_order.back();
-            url_cache.erase(lru_key);
-            cache_order.pop_back();
-        }
-
-        // Insert new entry at front
-        cache_order.push_front(url);
-        url_cache[url] = {result, cache_order.begin()};
-    }
-
+    auto result = std::make_shared<const std::vector<uint8_t>>(std::move(raw_data));
+    ImageMemoryCache().put(url, result);
     return result;
 }
 
-std::vector<uint8_t> convertToPngBuffer(const unsigned char* jpg_data, size_t jpg_size) {
-    int width, height, channels;
-    unsigned char* image_data = stbi_load_from_memory(jpg_data, static_cast<int>(jpg_size), &width, &height, &channels, 4); // force RGBA
-    if (!image_data) {
-        throw std::runtime_error("Failed to decode JPG image.");
-    }
-
-    std::vector<uint8_t> pngBuffer;
-    auto writeFunc = [](void* context, void* data, int size) {
-        auto* buffer = reinterpret_cast<std::vector<uint8_t>*>(context);
-        buffer->insert(buffer->end(), (uint8_t*)data, (uint8_t*)data + size);
-    };
-
-    if (!stbi_write_png_to_func(writeFunc, &pngBuffer, width, height, 4, image_data, width * 4)) {
-        stbi_image_free(image_data);
-        throw std::runtime_error("Failed to encode PNG.");
-    }
-
-    stbi_image_free(image_data);
-    return pngBuffer;
-}
-
 std::vector<uint8_t> fetchUrl(const std::string& url, FetchType fetchType) {
     //if (fetchType == FetchType::PNG) return get_fallback_default_png();
 
     std::string effective_url = url;
     if (fetchType == FetchType::PNG) effective_url = "https://content.warframe.com/PublicExport" + url;
     //LogThis("Fetching url: " + effective_url);
-    CURL* curl = curl_easy_init();
-    if (!curl) throw std::runtime_error("curl_easy_init() failed");
+    const auto lease = HttpClient::instance().acquire();
+    if (!lease) throw std::runtime_error("curl_easy_init() failed");
+    CURL* curl = lease->get();
 
     std::vector<uint8_t> readBuffer;
     long httpCode = 0;
@@ -190,36 +237,30 @@ std::vector<uint8_t> fetchUrl(const std::string& url, FetchType fetchType) {
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl/1.0");
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
 
     CURLcode res = curl_easy_perform(curl);
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
 
     if (res != CURLE_OK) {
-        curl_easy_cleanup(curl);
         LogThis("curl_easy_perform() failed: " + std::string(curl_easy_strerror(res)) + ", returned empty instead for url: " + effective_url);
         return {};
     }
     if (httpCode != 200) {
-        curl_easy_cleanup(curl);
         LogThis("HTTP code: " + std::to_string(httpCode) + ", returned empty instead for url: " + effective_url);
         return {};
     }
 
-    curl_easy_cleanup(curl);
-
     //LogThis("Successfully fetched url: " + effective_url);
     switch (fetchType) {
         case FetchType::STRING:
             return readBuffer;
 
         case FetchType::PNG:
-            if (isValidPng(readBuffer)) {
+            //kept as downloaded, the Qt image readers handle both
+            if (isValidPng(readBuffer) || isValidJpg(readBuffer)) {
                 return readBuffer;
             }
-            if  (isValidJpg(readBuffer)) {
-                auto pngData = convertToPngBuffer(readBuffer.data(), readBuffer.size());
-                return pngData; // PNG format now
-            }
             LogThis("Image not valid for " + effective_url);
             return {};
 
@@ -246,37 +287,221 @@ bool UpdatePlayerData(std::string extra) {
         return false;
     }
     SaveDataAt(result, "../data/Player/player_data.json");
+    InvalidateData(DataType::Player);
+    return true;
+}
+
+namespace {
+
+constexpr size_t maxParallelDownloads = 8;
+const std::string exportDir = "../data/Warframe/";
+
+struct ManifestEntry {
+    std::string line; //filename incl. the version suffix, used for the url
+    std::string file; //plain filename we save as
+};
+
+std::string StagingPath(const ManifestEntry& entry) {
+    return exportDir + entry.file + ".part";
+}
+
+void RemoveStaged(const std::vector<ManifestEntry>& entries) {
+    std::error_code ec;
+    for (const auto& entry : entries) {
+        std::filesystem::remove(StagingPath(entry), ec);
+    }
+}
+
+std::string BackupPath(const ManifestEntry& entry) {
+    return exportDir + entry.file + ".old";
+}
+
+//moves every current export aside, then the staged ones in; if any rename fails the ones already
+//replaced get their backup back, so the exports are either all new or all old
+bool CommitStaged(const std::vector<ManifestEntry>& entries) {
+    struct Replaced {
+        const ManifestEntry* entry;
+        bool backedUp; //false for exports we did not have before
+    };
+    std::vector<Replaced> replaced;
+    replaced.reserve(entries.size());
+
+    auto restore = [](const Replaced& done) {
+        const std::string current = exportDir + done.entry->file;
+        std::error_code ec;
+        if (done.backedUp) {
+            std::filesystem::rename(BackupPath(*done.entry), current, ec);
+        } else {
+            std::filesystem::remove(current, ec);
+        }
+        if (ec) {
+            LogThis(LogLevel::Error, "could not restore ", done.entry->file, ": ", ec.message());
+        }
+    };
+
+    for (const auto& entry : entries) {
+        const std::string current = exportDir + entry.file;
+        std::error_code ec;
+        std::filesystem::remove(BackupPath(entry), ec); //left over from an update that was killed halfway
+        Replaced done{&entry, std::filesystem::exists(current, ec)};
+        if (!ec && done.backedUp) {
+            std::filesystem::rename(current, BackupPath(entry), ec);
+        }
+        if (!ec) {
+            std::filesystem::rename(StagingPath(entry), current, ec);
+            if (ec && done.backedUp) restore(done);
+        }
+        if (ec) {
+            LogThis(LogLevel::Error, "could not replace ", entry.file, ": ", ec.message(), ", keeping the old exports");
+            for (auto it = replaced.rbegin(); it != replaced.rend(); ++it) {
+                restore(*it);
+            }
+            return false;
+        }
+        replaced.push_back(done);
+    }
+
+    std::error_code ec;
+    for (const Replaced& done : replaced) {
+        if (done.backedUp) std::filesystem::remove(BackupPath(*done.entry), ec);
+    }
     return true;
 }
 
-void FetchGameUpdate() {
+//the index of the last successful update; its lines carry the version suffix of every export we have
+const std::string lastIndexPath = exportDir + "index_en.txt";
+
+std::unordered_set<std::string> LoadLastIndex() {
+    std::unordered_set<std::string> lines;
+    std::ifstream file(lastIndexPath);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty()) lines.insert(line);
+    }
+    return lines;
+}
+
+bool SaveLastIndex(const std::vector<ManifestEntry>& entries) {
+    std::string content;
+    for (const auto& entry : entries) {
+        content += entry.line + "\n";
+    }
+    const std::string tmpPath = lastIndexPath + ".part";
+    if (!SaveDataAt(content, tmpPath)) return false;
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, lastIndexPath, ec);
+    return !ec;
+}
+
+} // namespace
+
+GameUpdateResult FetchGameUpdate(const UpdateProgressCallback& progress) {
     LogThis("called FetchGameUpdate");
     std::vector<uint8_t> vec = fetchUrl("https://origin.warframe.com/PublicExport/index_en.txt.lzma", FetchType::LZMA);
     std::string index(vec.begin(), vec.end());
     std::istringstream iss(index);
     std::string line;
-    std::string trimmed;
-    std::vector<uint8_t> vec2;
-    std::string data;
+    std::vector<ManifestEntry> entries;
     size_t linenum = 0;
     while (std::getline(iss, line)) {
         ++linenum;
         if (!line.empty() && line.back() == '\r') //Carriage returns are my nemesis
             line.pop_back();
-        LogThis("Streamline #" + std::to_string(linenum) + ": " + line);
-        trimmed = line.size() > 30 ? line.substr(0, line.size() - 26) : ""; //warframe adds 26 extra characters for version but we just want till .json
-        LogThis("trimmed: '" + trimmed + "'");
-        vec2 = fetchUrl("https://content.warframe.com/PublicExport/Manifest/" + line, FetchType::STRING);
-        LogThis("2nd fetch for " + line + " got size " + std::to_string(vec2.size()));
-        data.assign(vec2.begin(), vec2.end());
-        if (!data.empty()) {
-            LogThis("data for " + line + " starts: '" + data.substr(0, 80) + "'");
+        LogThis(LogLevel::Debug, "Streamline #", linenum, ": ", line);
+        if (line.size() <= 30) continue; //warframe adds 26 extra characters for version but we just want till .json
+        std::string trimmed = line.substr(0, line.size() - 26);
+        LogThis(LogLevel::Debug, "trimmed: '", trimmed, "'");
+        entries.push_back({line, std::move(trimmed)});
+    }
+    if (entries.empty()) {
+        LogThis(LogLevel::Error, "game update index was empty, keeping the current exports");
+        return {};
+    }
+
+    //the suffix changes whenever DE updates a file, so an unchanged line means our copy is current
+    const std::unordered_set<std::string> lastIndex = LoadLastIndex();
+    std::vector<ManifestEntry> outdated;
+    for (const auto& entry : entries) {
+        if (!lastIndex.contains(entry.line) || !std::filesystem::exists(exportDir + entry.file)) {
+            outdated.push_back(entry);
         }
-        SaveDataAt(data, "../data/Warframe/" + trimmed);
-        LogThis("Data Saved");
+    }
+    if (outdated.empty()) {
+        LogThis("Game data is already up to date");
+        return {true, {}};
+    }
+    LogThis(std::to_string(outdated.size()) + " of " + std::to_string(entries.size()) + " exports changed");
+
+    std::error_code ec;
+    std::filesystem::create_directories(exportDir, ec);
+
+    //every file is downloaded into a staging file first; only when all of them arrived they replace the
+    //current exports, so a failed update never leaves a mix of old and half written files behind
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::mutex progressMutex;
+    if (progress) progress(0, outdated.size());
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < outdated.size() && !failed; i = next++) {
+            const ManifestEntry& entry = outdated[i];
+            const std::vector<uint8_t> data = fetchUrl("https://content.warframe.com/PublicExport/Manifest/" + entry.line, FetchType::STRING);
+            LogThis(LogLevel::Debug, "2nd fetch for ", entry.line, " got size ", data.size());
+            if (data.empty()) {
+                LogThis(LogLevel::Error, "download of ", entry.line, " failed, aborting game update");
+                failed = true;
+                return;
+            }
+            if (!SaveDataAt(std::string(data.begin(), data.end()), StagingPath(entry), std::ios::out | std::ios::binary)) {
+                LogThis(LogLevel::Error, "could not write ", StagingPath(entry), ", aborting game update");
+                failed = true;
+                return;
+            }
+            LogThis(LogLevel::Debug, "Data Saved");
+
+            const size_t finished = ++done;
+            if (progress) {
+                std::lock_guard lock(progressMutex);
+                progress(finished, outdated.size());
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t workerCount = std::min(maxParallelDownloads, outdated.size());
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
     }
 
-    LogThis("Done with FetchGameUpdate loop");
+    if (failed) {
+        RemoveStaged(outdated);
+        return {};
+    }
+
+    if (!CommitStaged(outdated)) {
+        RemoveStaged(outdated);
+        return {};
+    }
+
+    GameUpdateResult result{true, {}};
+    for (const auto& entry : outdated) {
+        if (const auto type = DataTypeFromExportFile(entry.file)) {
+            InvalidateData(*type);
+            result.changed.push_back(*type);
+        }
+    }
+
+    if (!SaveLastIndex(entries)) {
+        LogThis(LogLevel::Error, "could not save ", lastIndexPath, ", next update downloads everything again");
+    }
+
+    LogThis("Done with FetchGameUpdate, updated " + std::to_string(outdated.size()) + " exports");
+    return result;
 }
 
 
@@ -1,26 +1,36 @@
 #ifndef APIPARSER_H
 #define APIPARSER_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <curl/curl.h>
 
+#include "FileAccess/FileAccess.h"
+
 enum class FetchType {
     STRING,
-    PNG,
+    PNG, //images in general, png or jpg bytes as downloaded
     LZMA
 };
 
 // Fetches url content
 std::vector<uint8_t> fetchUrl(const std::string& effective_url, FetchType fetchType);
 std::shared_ptr<const std::vector<uint8_t>>  fetchUrlCached(const std::string& effective_url, FetchType fetchType);
+std::shared_ptr<const std::vector<uint8_t>> getFallbackDefaultPng(); //what fetchUrlCached returns for a failed download
 
-void FetchGameUpdate(); //as self explanatory as the one above ;). saves to data/warframe as .json
-bool UpdatePlayerData(std::string extra = "");
+// (finished, total) manifest files; called from the download threads, one call at a time
+using UpdateProgressCallback = std::function<void(size_t, size_t)>;
 
-//for the url fetch cache
-const size_t CACHE_LIMIT = 30;
+struct GameUpdateResult {
+    bool success = false;
+    std::vector<DataType> changed; //exports that were replaced and invalidated; empty if all were current
+};
 
+// Downloads every export whose version changed since the last update (in parallel) and saves it to
+// data/warframe as .json. Keeps the old files if any download or replacing one of them failed.
+GameUpdateResult FetchGameUpdate(const UpdateProgressCallback& progress = {});
+bool UpdatePlayerData(std::string extra = "");
 
 #endif //APIPARSER_H
@@ -4,6 +4,8 @@
 #include <QMetaObject>
 #include <fstream>
 #include "FileAccess/FileAccess.h"
+#include "apiParser/apiParser.h"
+#include "dataReader/dataReader.h"
 
 BackgroundWorker::BackgroundWorker(MainWindow* mw)
     : QObject(nullptr), running(true), mainWindow(mw), timer(new QTimer(this)) {
@@ -121,9 +123,24 @@ void BackgroundWorker::backgroundWork() {
 
 
 void BackgroundWorker::triggerUpdate() {
+    //goes through the UI thread first so manual and timed syncs share the same guard
     if (mainWindow) {
-        QMetaObject::invokeMethod(mainWindow, [this]() {
-            mainWindow->updatePlayerData();
+        QMetaObject::invokeMethod(mainWindow, &MainWindow::requestSync, Qt::QueuedConnection);
+    }
+}
+
+void BackgroundWorker::syncInventory() {
+    Settings settings = MainWindow::getWindowSettings();
+    bool success = UpdatePlayerData(settings.nonce); //TODO: maybe do something on fail idk put a warning banner up
+    if (!success) {
+        LogThis("player data failed to download; check if auth is set correctly");
+    }
+
+    std::shared_ptr<const InventorySnapshot> snapshot = BuildInventorySnapshot();
+
+    if (mainWindow) {
+        QMetaObject::invokeMethod(mainWindow, [window = mainWindow, snapshot]() {
+            window->applyInventory(snapshot);
         }, Qt::QueuedConnection);
     }
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ public:
 public slots:
     void startWork();
     void stopWork();
+    void syncInventory(); //download + parse player data on this thread, then hand the snapshot to the UI
 
 private slots:
     void backgroundWork();
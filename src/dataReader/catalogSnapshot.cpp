@@ -0,0 +1,369 @@
+#include "catalogSnapshot.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "FileAccess/FileAccess.h"
+
+namespace {
+
+//bump this whenever the layout below changes; old snapshots are then simply rebuilt
+constexpr uint32_t snapshotVersion = 1;
+constexpr char snapshotMagic[4] = {'A', 'W', 'P', 'C'};
+
+// ---------- export hashing ----------
+
+uint64_t Fnv1a(const char* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string ReadBinaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return {};
+    std::string content(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(content.data(), static_cast<std::streamsize>(content.size()));
+    return content;
+}
+
+struct FileHash {
+    uintmax_t size = 0;
+    std::filesystem::file_time_type writeTime{};
+    uint64_t hash = 0;
+};
+
+std::mutex hashMutex;
+std::unordered_map<DataType, FileHash> hashCache;
+
+//content hash of one export; only re-read when size or write time changed since the last call
+uint64_t HashOfExport(DataType type) {
+    const std::string path = PathFromDataType(type);
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) return 0;
+    const auto writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec) return 0;
+
+    std::lock_guard lock(hashMutex);
+    auto it = hashCache.find(type);
+    if (it != hashCache.end() && it->second.size == size && it->second.writeTime == writeTime) {
+        return it->second.hash;
+    }
+
+    const std::string content = ReadBinaryFile(path);
+    FileHash entry{size, writeTime, Fnv1a(content.data(), content.size())};
+    hashCache[type] = entry;
+    return entry.hash;
+}
+
+} // namespace
+
+std::vector<DataType> CatalogDependencies(CatalogKind kind) {
+    //the names are built from these, see GameDataStore::refreshNames
+    std::vector<DataType> names = {
+        DataType::Warframes, DataType::Weapons, DataType::Sentinels,
+        DataType::Resources, DataType::Mods, DataType::Customs
+    };
+    switch (kind) {
+        case CatalogKind::Recipes:
+            names.insert(names.end(), {DataType::Blueprints, DataType::Images});
+            return names;
+        case CatalogKind::Relics:
+            names.insert(names.end(), {DataType::Relics, DataType::Blueprints, DataType::Images});
+            return names;
+        case CatalogKind::Arcanes:
+            return {DataType::Relics, DataType::Images};
+        case CatalogKind::Mods:
+            return {DataType::Mods, DataType::Images};
+    }
+    return {};
+}
+
+bool CatalogDependsOn(CatalogKind kind, const std::vector<DataType>& changed) {
+    for (DataType type : CatalogDependencies(kind)) {
+        if (std::find(changed.begin(), changed.end(), type) != changed.end()) return true;
+    }
+    return false;
+}
+
+namespace {
+
+uint64_t KeyOf(CatalogKind kind) {
+    uint64_t key = 14695981039346656037ull;
+    for (DataType type : CatalogDependencies(kind)) {
+        const uint64_t fileHash = HashOfExport(type);
+        key = Fnv1a(reinterpret_cast<const char*>(&fileHash), sizeof(fileHash), key);
+    }
+    return key;
+}
+
+std::string snapshotDirectory = cachePath;
+
+std::string PathOf(CatalogKind kind) {
+    switch (kind) {
+        case CatalogKind::Recipes: return snapshotDirectory + "recipes.bin";
+        case CatalogKind::Relics:  return snapshotDirectory + "relics.bin";
+        case CatalogKind::Arcanes: return snapshotDirectory + "arcanes.bin";
+        case CatalogKind::Mods:    return snapshotDirectory + "mods.bin";
+    }
+    return snapshotDirectory + "unknown.bin";
+}
+
+// ---------- writing ----------
+
+struct Writer {
+    std::string buffer;
+
+    template<typename T>
+    void pod(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void str(const std::string& value) {
+        pod(static_cast<uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+    //interned ids are stored as their string, handles are only valid for one run
+    void id(ItemId value) {
+        str(IdString(value));
+    }
+
+    void item(const ItemData& data) {
+        id(data.id);
+        id(data.craftedId);
+        str(data.name);
+        id(data.image);
+        pod(static_cast<uint32_t>(data.category));
+    }
+
+    void item(const RelicData& data) {
+        id(data.id);
+        id(data.craftedId);
+        str(data.name);
+        id(data.image);
+        pod(static_cast<uint32_t>(data.category));
+        pod(static_cast<uint8_t>(data.rarity));
+    }
+
+    void item(const Recipe& recipe) {
+        item(recipe.mainItem);
+        pod(static_cast<uint32_t>(recipe.subItems.size()));
+        for (const auto& sub : recipe.subItems) item(sub);
+    }
+
+    void item(const Relic& relic) {
+        item(relic.mainItem);
+        pod(static_cast<uint32_t>(relic.subItems.size()));
+        for (const auto& sub : relic.subItems) item(sub);
+    }
+
+    void item(const Arcane& arcane) {
+        id(arcane.id);
+        str(arcane.name);
+        id(arcane.image);
+        pod(static_cast<uint32_t>(arcane.category));
+        pod(static_cast<uint8_t>(arcane.rarity));
+        pod(static_cast<uint32_t>(arcane.stats.size()));
+        for (const auto& stat : arcane.stats) str(stat);
+    }
+
+    void item(const Mod& mod) {
+        id(mod.id);
+        str(mod.name);
+        id(mod.image);
+        pod(static_cast<uint32_t>(mod.category));
+        pod(static_cast<uint8_t>(mod.rarity));
+        pod(static_cast<int32_t>(mod.baseDrain));
+        pod(static_cast<int32_t>(mod.fusionLimit));
+    }
+};
+
+// ---------- reading ----------
+
+//bounds checked reader; any read past the end just sets ok = false and returns defaults
+struct Reader {
+    const char* pos;
+    const char* end;
+    bool ok = true;
+
+    template<typename T>
+    T pod() {
+        T value{};
+        if (!ok || static_cast<size_t>(end - pos) < sizeof(T)) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    void str(std::string& out) {
+        const auto size = pod<uint32_t>();
+        if (!ok || static_cast<size_t>(end - pos) < size) {
+            ok = false;
+            return;
+        }
+        out.assign(pos, size);
+        pos += size;
+    }
+
+    void id(ItemId& out) {
+        const auto size = pod<uint32_t>();
+        if (!ok || static_cast<size_t>(end - pos) < size) {
+            ok = false;
+            return;
+        }
+        out = InternId(std::string_view(pos, size));
+        pos += size;
+    }
+
+    //guards reserve() against garbage sizes from a broken file
+    uint32_t count() {
+        const auto value = pod<uint32_t>();
+        if (value > static_cast<size_t>(end - pos)) ok = false;
+        return ok ? value : 0;
+    }
+
+    void item(ItemData& data) {
+        id(data.id);
+        id(data.craftedId);
+        str(data.name);
+        id(data.image);
+        data.category = static_cast<InventoryCategories>(pod<uint32_t>());
+    }
+
+    void item(RelicData& data) {
+        id(data.id);
+        id(data.craftedId);
+        str(data.name);
+        id(data.image);
+        data.category = static_cast<InventoryCategories>(pod<uint32_t>());
+        data.rarity = static_cast<Rarity>(pod<uint8_t>());
+    }
+
+    void item(Recipe& recipe) {
+        item(recipe.mainItem);
+        recipe.subItems.resize(count());
+        for (auto& sub : recipe.subItems) item(sub);
+    }
+
+    void item(Relic& relic) {
+        item(relic.mainItem);
+        relic.subItems.resize(count());
+        for (auto& sub : relic.subItems) item(sub);
+    }
+
+    void item(Arcane& arcane) {
+        id(arcane.id);
+        str(arcane.name);
+        id(arcane.image);
+        arcane.category = static_cast<InventoryCategories>(pod<uint32_t>());
+        arcane.rarity = static_cast<Rarity>(pod<uint8_t>());
+        arcane.stats.resize(count());
+        for (auto& stat : arcane.stats) str(stat);
+    }
+
+    void item(Mod& mod) {
+        id(mod.id);
+        str(mod.name);
+        id(mod.image);
+        mod.category = static_cast<InventoryCategories>(pod<uint32_t>());
+        mod.rarity = static_cast<Rarity>(pod<uint8_t>());
+        mod.baseDrain = pod<int32_t>();
+        mod.fusionLimit = pod<int32_t>();
+    }
+};
+
+template<typename T>
+bool Load(CatalogKind kind, std::vector<T>& out) {
+    out.clear();
+    const std::string path = PathOf(kind);
+    const std::string content = ReadBinaryFile(path);
+    if (content.empty()) return false;
+
+    Reader reader{content.data(), content.data() + content.size()};
+    char magic[4]{};
+    for (char& c : magic) c = reader.pod<char>();
+    if (!reader.ok || std::memcmp(magic, snapshotMagic, sizeof(magic)) != 0 ||
+        reader.pod<uint32_t>() != snapshotVersion ||
+        reader.pod<uint32_t>() != static_cast<uint32_t>(kind)) {
+        LogThis("Snapshot " + path + " has an unknown format, rebuilding");
+        return false;
+    }
+    if (reader.pod<uint64_t>() != KeyOf(kind)) {
+        LogThis("Snapshot " + path + " is outdated, rebuilding");
+        return false;
+    }
+
+    out.resize(reader.count());
+    for (auto& entry : out) {
+        reader.item(entry);
+    }
+    if (!reader.ok || reader.pos != reader.end) {
+        LogThis("Snapshot " + path + " is broken, rebuilding");
+        out.clear();
+        return false;
+    }
+
+    LogThis("Loaded " + std::to_string(out.size()) + " entries from snapshot " + path);
+    return true;
+}
+
+template<typename T>
+void Save(CatalogKind kind, const std::vector<T>& data) {
+    Writer writer;
+    for (char c : snapshotMagic) writer.pod(c);
+    writer.pod(snapshotVersion);
+    writer.pod(static_cast<uint32_t>(kind));
+    writer.pod(KeyOf(kind));
+    writer.pod(static_cast<uint32_t>(data.size()));
+    for (const auto& entry : data) {
+        writer.item(entry);
+    }
+
+    const std::string path = PathOf(kind);
+    std::error_code ec;
+    std::filesystem::create_directories(snapshotDirectory, ec);
+
+    //write next to it first so a crash never leaves a half written snapshot behind
+    const std::string tmpPath = path + ".tmp";
+    if (!SaveDataAt(writer.buffer, tmpPath, std::ios::out | std::ios::binary)) {
+        LogThis("Failed to write snapshot " + tmpPath);
+        return;
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        LogThis("Failed to replace snapshot " + path + ": " + ec.message());
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+} // namespace
+
+bool LoadSnapshot(std::vector<Recipe>& out) { return Load(CatalogKind::Recipes, out); }
+bool LoadSnapshot(std::vector<Relic>& out) { return Load(CatalogKind::Relics, out); }
+bool LoadSnapshot(std::vector<Arcane>& out) { return Load(CatalogKind::Arcanes, out); }
+bool LoadSnapshot(std::vector<Mod>& out) { return Load(CatalogKind::Mods, out); }
+
+void SaveSnapshot(const std::vector<Recipe>& recipes) { Save(CatalogKind::Recipes, recipes); }
+void SaveSnapshot(const std::vector<Relic>& relics) { Save(CatalogKind::Relics, relics); }
+void SaveSnapshot(const std::vector<Arcane>& arcanes) { Save(CatalogKind::Arcanes, arcanes); }
+void SaveSnapshot(const std::vector<Mod>& mods) { Save(CatalogKind::Mods, mods); }
+
+void SetSnapshotDirectory(const std::string& directory) {
+    snapshotDirectory = directory;
+    if (!snapshotDirectory.empty() && snapshotDirectory.back() != '/') snapshotDirectory += '/';
+}
@@ -0,0 +1,41 @@
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "dataReader.h"
+#include "FileAccess/FileAccess.h"
+
+// Binary snapshots of the item vectors built by GetRecipes/GetRelics/GetArcanes/GetMods.
+// Only the export derived fields are stored; counts and mastery are player data and have to be
+// refreshed with UpdateCounts after loading. A snapshot is keyed by the hashes of the export files
+// it was built from, so it is rebuilt automatically once FetchGameUpdate changed one of them.
+
+//values are stored in the snapshot header, do not renumber
+enum class CatalogKind : uint32_t {
+    Recipes = 1,
+    Relics  = 2,
+    Arcanes = 3,
+    Mods    = 4
+};
+
+//exports the catalog (and its name/image lookups) is built from
+std::vector<DataType> CatalogDependencies(CatalogKind kind);
+bool CatalogDependsOn(CatalogKind kind, const std::vector<DataType>& changed);
+
+//return false if there is no snapshot or it is outdated/broken; 'out' is left empty in that case
+bool LoadSnapshot(std::vector<Recipe>& out);
+bool LoadSnapshot(std::vector<Relic>& out);
+bool LoadSnapshot(std::vector<Arcane>& out);
+bool LoadSnapshot(std::vector<Mod>& out);
+
+void SaveSnapshot(const std::vector<Recipe>& recipes);
+void SaveSnapshot(const std::vector<Relic>& relics);
+void SaveSnapshot(const std::vector<Arcane>& arcanes);
+void SaveSnapshot(const std::vector<Mod>& mods);
+
+//cachePath unless changed; for tools that must not read or replace the app's own snapshots
+void SetSnapshotDirectory(const std::string& directory);
+
+#endif //CATALOGSNAPSHOT_H
@@ -1,12 +1,18 @@
 #include "dataReader.h"
 
+#include <algorithm>
 #include <fstream>
+#include <mutex>
 #include <regex>
 #include <vector>
 #include <nlohmann/json.hpp>
 #include <type_traits>
 #include <unordered_set>
 
+#include "catalogSnapshot.h"
+#include "gameDataStore.h"
+#include "keywordMatcher.h"
+#include "playerReader.h"
 #include "FileAccess/FileAccess.h"
 
 
@@ -68,66 +74,120 @@ ReturnType getValueByKey(const JsonType& jsonData,
     }
 }
 
-std::string nameFromId(const std::string& id, bool supressError = false) {
-    if (NameMap.empty()) {
-        RefreshNameMap();
+//same as getValueByKey but hands out a reference into jsonData instead of copying whole export arrays
+template<typename JsonType = nlohmann::json>
+const JsonType& getRefByKey(const JsonType& jsonData,
+                            const std::string& key,
+                            bool suppressError = false)
+{
+    static const JsonType empty{};
+    auto it = jsonData.find(key);
+    if (it == jsonData.end()) {
+        if (!suppressError) LogThis("Key not found: " + key);
+        return empty;
     }
+    return *it;
+}
 
-    if (auto nameIt = NameMap.find(id); nameIt != NameMap.end()) {
-        return nameIt->second;
+//falls back to the id itself if no name is known
+const std::string& nameFromId(ItemId id, bool supressError = false) {
+    if (const std::string* name = GameData().name(id)) {
+        return *name;
     }
     if (!supressError) {
-        LogThis("Name not found! check: " + id);
+        LogThis("Name not found! check: " + IdString(id));
     }
 
-    return id;
+    return IdString(id);
 }
 
-//Important that this functions on the final product id not the blueprint;
-InventoryCategories GetItemCategoryFromId(const std::string& id) {
+//looks the id up without interning it; the name table interns every id it knows while being built
+std::string nameFromId(const std::string& id, bool supressError = false) {
+    GameData().ensureLoaded();
+    const ItemId handle = FindId(id);
+    if (handle == NoItemId) {
+        if (!supressError) {
+            LogThis("Name not found! check: " + id);
+        }
+        return id;
+    }
+    return nameFromId(handle, supressError);
+}
+
+//every substring GetItemCategoryFromId cares about; the automaton finds all of them in one pass over the id
+enum CategoryKeyword : size_t {
+    KwPrime, KwExcaliburPrime, KwLatoPrime, KwSkanaPrime, KwPowersuits, KwWeapon, KwKuvaLich, KwBoardExec,
+    KwInfestedLich, KwVoidTrader, KwWeaponParts, KwResources, KwPet, KwSentinel, KwMech, KwThanoTech,
+    KwNechroTech, KwArchwing, KwDojoSpecial, KwResearch, KwLandingCraft, KwShips, KwHoverboard, KwModular, KwVandal
+};
+
+const KeywordMatcher& CategoryMatcher() {
+    static const KeywordMatcher matcher({
+        "Prime", "/Lotus/Powersuits/Excalibur/ExcaliburPrime", "/Lotus/Weapons/Tenno/Pistol/LatoPrime",
+        "/Lotus/Weapons/Tenno/Melee/LongSword/SkanaPrime", "/Lotus/Powersuits/", "Weapon", "KuvaLich", "BoardExec",
+        "InfestedLich", "VoidTrader", "WeaponParts", "Resources", "Pet", "Sentinel", "Mech", "ThanoTech",
+        "NechroTech", "Archwing", "DojoSpecial", "Research", "LandingCraft", "Ships", "Hoverboard", "Modular", "Vandal"
+    });
+    return matcher;
+}
+
+//results per id; the Kuva/Tenet fallbacks depend on the names, so RefreshGameDataMaps clears this
+std::mutex categoryCacheMutex;
+std::unordered_map<ItemId, InventoryCategories> categoryCache;
+
+void ClearCategoryCache() {
+    std::lock_guard lock(categoryCacheMutex);
+    categoryCache.clear();
+}
+
+//itemId is NoItemId for ids that were never interned, those have no name for the Kuva/Tenet fallbacks
+InventoryCategories ClassifyItem(const std::string& id, ItemId itemId) {
+    const uint64_t found = CategoryMatcher().match(id);
+    auto has = [found](CategoryKeyword keyword) {
+        return (found & (uint64_t{1} << keyword)) != 0;
+    };
+
     InventoryCategories category = InventoryCategories::None;
 
     // Prime
-    if (id.find("Prime") != std::string::npos) {
+    if (has(KwPrime)) {
         category = addCategory(category, InventoryCategories::Prime);
         //special founder exclusives
-        if (id.find("/Lotus/Powersuits/Excalibur/ExcaliburPrime") != std::string::npos ||
-        id.find("/Lotus/Weapons/Tenno/Pistol/LatoPrime") != std::string::npos ||
-        id.find("/Lotus/Weapons/Tenno/Melee/LongSword/SkanaPrime") != std::string::npos) {
+        if (has(KwExcaliburPrime) || has(KwLatoPrime) || has(KwSkanaPrime)) {
             category = addCategory(category, InventoryCategories::FounderSpecial);
             return category;
         }
     }
 
     // Warframe & related
-    if (id.find("/Lotus/Powersuits/") != std::string::npos) {
+    if (has(KwPowersuits)) {
         category = addCategory(category, InventoryCategories::Warframe);
     }
 
     // Weapon & components
-    if (id.find("Weapon") != std::string::npos && !hasCategory(category, InventoryCategories::Warframe)) {
+    if (has(KwWeapon) && !hasCategory(category, InventoryCategories::Warframe)) {
         // Lich Nemesis
-        if (id.find("KuvaLich") != std::string::npos) {
+        if (has(KwKuvaLich)) {
             category = addCategory(category, InventoryCategories::Nemesis);
         }
         //Kuva 2nd try
-        else if (nameFromId(id).rfind("Kuva", 0) == 0) {
+        else if (itemId != NoItemId && nameFromId(itemId).rfind("Kuva", 0) == 0) {
             category = addCategory(category, InventoryCategories::Nemesis);
         }
         // Sister Nemesis
-        else if (id.find("BoardExec") != std::string::npos) {
+        else if (has(KwBoardExec)) {
             category = addCategory(category, InventoryCategories::Nemesis);
         }
         //Tenet 2nd try
-        else if (nameFromId(id).rfind("Tenet", 0) == 0) {
+        else if (itemId != NoItemId && nameFromId(itemId).rfind("Tenet", 0) == 0) {
             category = addCategory(category, InventoryCategories::Nemesis);
         }
         // Coda Nemesis
-        else if (id.find("InfestedLich") != std::string::npos) {
+        else if (has(KwInfestedLich)) {
             category = addCategory(category, InventoryCategories::Nemesis);
         }
         //Sold by Baro Ki'Teer
-        else if (id.find("VoidTrader") != std::string::npos) {
+        else if (has(KwVoidTrader)) {
             category = addCategory(category, InventoryCategories::DucatItem);
         }
         //just a weapon
@@ -135,27 +195,27 @@ InventoryCategories GetItemCategoryFromId(const std::string& id) {
     }
 
     // WeaponParts as Component
-    if (id.find("WeaponParts") != std::string::npos) {
+    if (has(KwWeaponParts)) {
         category = addCategory(category, InventoryCategories::Component | InventoryCategories::Weapon | InventoryCategories::NoMastery);
     }
 
     //catch all for Resources
-    if (id.find("Resources") != std::string::npos) {
+    if (has(KwResources)) {
         category = addCategory(category, InventoryCategories::Component | InventoryCategories::NoMastery);
     }
 
     // Companion
-    if (id.find("Pet") != std::string::npos || id.find("Sentinel") != std::string::npos) {
+    if (has(KwPet) || has(KwSentinel)) {
         category = addCategory(category, InventoryCategories::Companion);
     }
 
     // Necramech
-    if (id.find("Mech") != std::string::npos || id.find("ThanoTech") != std::string::npos || id.find("NechroTech") != std::string::npos) {
+    if (has(KwMech) || has(KwThanoTech) || has(KwNechroTech)) {
         category = addCategory(category, InventoryCategories::Necramech);
     }
 
     // Archwing and Archweapon
-    if (id.find("Archwing") != std::string::npos) {
+    if (has(KwArchwing)) {
         if (hasCategory(category, InventoryCategories::Weapon)) {
             category = addCategory(category, InventoryCategories::Archweapon);
         } else {
@@ -164,48 +224,48 @@ InventoryCategories GetItemCategoryFromId(const std::string& id) {
     }
 
     // DojoSpecial = Research
-    if (id.find("DojoSpecial") != std::string::npos || id.find("Research") != std::string::npos) {
+    if (has(KwDojoSpecial) || has(KwResearch)) {
         category = addCategory(category, InventoryCategories::DojoSpecial | InventoryCategories::NoMastery);
     }
 
     // LandingCraft & Ships
-    if (id.find("LandingCraft") != std::string::npos || id.find("Ships") != std::string::npos) {
+    if (has(KwLandingCraft) || has(KwShips)) {
         category = addCategory(category, InventoryCategories::LandingCraft | InventoryCategories::NoMastery);
     }
 
     // Modular (for some reason the spectra Vandal is under 'CorpusModularPistol')
-    if (id.find("Hoverboard") != std::string::npos || (id.find("Modular") != std::string::npos && id.find("Vandal") == std::string::npos)) {
+    if (has(KwHoverboard) || (has(KwModular) && !has(KwVandal))) {
         category = addCategory(category, InventoryCategories::Modular);
     }
 
     return category;
 }
 
-std::unordered_map<std::string, std::string> extractMapFromArray(
-    const json& j,
-    const std::string& arrayKey,
-    const std::string& valueKey = "name")
-{
-    std::unordered_map<std::string, std::string> result;
-
-    // Check if arrayKey exists and is an array
-    if (!j.contains(arrayKey) || !j[arrayKey].is_array()) return result;
-
-    const auto& arr = j[arrayKey];
-
-    for (const auto& entry : arr) {
-        std::string id = entry.value("uniqueName", "");
-        std::string val = entry.value(valueKey, "");
-        if (!id.empty()) {
-            result[id] = val;
+//Important that this functions on the final product id not the blueprint;
+InventoryCategories GetItemCategoryFromId(ItemId id) {
+    {
+        std::lock_guard lock(categoryCacheMutex);
+        if (auto it = categoryCache.find(id); it != categoryCache.end()) {
+            return it->second;
         }
     }
+    //classify outside the lock, nameFromId may have to build the names first
+    const InventoryCategories category = ClassifyItem(IdString(id), id);
+    std::lock_guard lock(categoryCacheMutex);
+    categoryCache.emplace(id, category);
+    return category;
+}
 
-    return result;
+InventoryCategories GetItemCategoryFromId(const std::string& id) {
+    const ItemId handle = FindId(id);
+    if (handle == NoItemId) {
+        //in no export and no inventory, the id text is all there is to classify; not cached, the cache is per handle
+        return ClassifyItem(id, NoItemId);
+    }
+    return GetItemCategoryFromId(handle);
 }
 
-MasteryInfo GetMasteryLevelForItem(const std::string& itemId, int Affinity) {
-    InventoryCategories  cat = GetItemCategoryFromId(itemId);
+MasteryInfo GetMasteryLevelForItem(const std::string& itemId, InventoryCategories cat, int Affinity) {
     bool isWeapon = hasCategory(cat, InventoryCategories::Weapon);
     bool isOver40Capable = itemId.find("BallasSwordWeapon") != std::string::npos || hasCategory(cat, InventoryCategories::Nemesis) || (hasCategory(cat, InventoryCategories::Necramech) && !isWeapon);
     //BallasSwordWeapon = Paracesis
@@ -233,224 +293,87 @@ MasteryInfo GetMasteryLevelForItem(const std::string& itemId, int Affinity) {
     return MasteryInfo{level, maxRank, isWeapon};
 }
 
-std::string imgFromId(const std::string& id) {
-    if (ImgMap.empty()) {
-        RefreshImgMap();
-    }
-
-    if (auto imgIt = ImgMap.find(id); imgIt != ImgMap.end()) {
-        return imgIt->second;
-    }
-    LogThis("Img not found! check: " + id);
-    return "";
+MasteryInfo GetMasteryLevelForItem(const std::string& itemId, int Affinity) {
+    return GetMasteryLevelForItem(itemId, GetItemCategoryFromId(itemId), Affinity);
 }
 
-std::string resultFromBp(const std::string& bpId) {
-    if (BpToResultMap.empty()) {
-        RefreshResultBpMap();
-    }
-    if (auto it = BpToResultMap.find(bpId); it != BpToResultMap.end()) {
-        return it->second;
+ItemId imgFromId(ItemId id) {
+    const ItemId image = GameData().image(id);
+    if (image == NoItemId) {
+        LogThis(LogLevel::Debug, "Img not found! check: ", IdString(id));
     }
-
-    return bpId;
+    return image;
 }
 
-std::string bpFromResult(const std::string& resultId) {
-    if (ResultToBpMap.empty()) {
-        RefreshResultBpMap();
-    }
-    if (auto it = ResultToBpMap.find(resultId); it != ResultToBpMap.end()) {
-        return it->second;
+//looks the id up without interning it; the image table interns every id it knows while being built
+std::string imgFromId(const std::string& id) {
+    GameData().ensureLoaded();
+    const ItemId handle = FindId(id);
+    if (handle == NoItemId) {
+        LogThis(LogLevel::Debug, "Img not found! check: ", id);
+        return IdString(NoItemId);
     }
-
-    return resultId;
+    return IdString(imgFromId(handle));
 }
 
-void RefreshImgMap() {
-    ImgMap.clear();
-    const nlohmann::json images = ReadData(DataType::Images);
-    ImgMap = extractMapFromArray(images, "Manifest", "textureLocation");
-    LogThis("Loaded " + std::to_string(ImgMap.size()) + " image entries.");
+ItemId resultFromBp(ItemId bpId) {
+    const ItemId result = GameData().resultOf(bpId);
+    return result != NoItemId ? result : bpId;
 }
 
-void RefreshNameMap() {
-    NameMap.clear();
-    const nlohmann::json frames = ReadData(DataType::Warframes);
-    const nlohmann::json weapons = ReadData(DataType::Weapons);
-    const nlohmann::json companions = ReadData(DataType::Sentinels);
-    const nlohmann::json resources = ReadData(DataType::Resources);
-    const nlohmann::json mods = ReadData(DataType::Mods);
-    const nlohmann::json custom = ReadData(DataType::Customs);
-
-    std::unordered_map<std::string, std::string> idToWarframeName = extractMapFromArray(frames, "ExportWarframes");
-    LogThis("Loaded " + std::to_string(idToWarframeName.size()) + " warframe entries.");
-    NameMap.insert(idToWarframeName.begin(), idToWarframeName.end());
-
-    std::unordered_map<std::string, std::string> idToWeaponName = extractMapFromArray(weapons, "ExportWeapons");
-    LogThis("Loaded " + std::to_string(idToWeaponName.size()) + " weapon entries.");
-    NameMap.insert(idToWeaponName.begin(), idToWeaponName.end());
-
-    std::unordered_map<std::string, std::string> idToCompanionName = extractMapFromArray(companions, "ExportSentinels");
-    LogThis("Loaded " + std::to_string(idToCompanionName.size()) + " companion entries.");
-    NameMap.insert(idToCompanionName.begin(), idToCompanionName.end());
-
-    std::unordered_map<std::string, std::string> idToComponentName = extractMapFromArray(resources, "ExportResources");
-    LogThis("Loaded " + std::to_string(idToComponentName.size()) + " component entries.");
-    NameMap.insert(idToComponentName.begin(), idToComponentName.end());
-
-    std::unordered_map<std::string, std::string> idToModName = extractMapFromArray(mods, "ExportUpgrades");
-    LogThis("Loaded " + std::to_string(idToModName.size()) + " mod entries.");
-    NameMap.insert(idToModName.begin(), idToModName.end());
-
-    std::unordered_map<std::string, std::string> idToCustomName = extractMapFromArray(custom, "ExportCustoms");
-    LogThis("Loaded " + std::to_string(idToCustomName.size()) + " custom entries.");
-    NameMap.insert(idToCustomName.begin(), idToCustomName.end());
+ItemId bpFromResult(ItemId resultId) {
+    const ItemId bp = GameData().blueprintOf(resultId);
+    return bp != NoItemId ? bp : resultId;
 }
 
-void RefreshCountMap() {
-    CountMap.clear();
-
-    const auto& recipes = getValueByKey<nlohmann::json>(ReadData(DataType::Player), "Recipes");
-    const auto& misc    = getValueByKey<nlohmann::json>(ReadData(DataType::Player), "MiscItems");
-
-    auto processEntries = [&](const nlohmann::json& entries) {
-        for (const auto& entry : entries) {
-            std::string entryId   = entry.value("ItemType", "");
-            int         itemCount = entry.value("ItemCount", 0);
-            if (!entryId.empty()) {
-                CountMap[entryId] = itemCount;
-            }
-        }
+void RefreshGameDataMaps(const std::vector<DataType>& changed) {
+    auto anyChanged = [&changed](std::initializer_list<DataType> types) {
+        return std::ranges::any_of(types, [&changed](DataType type) {
+            return std::ranges::find(changed, type) != changed.end();
+        });
     };
 
-    processEntries(recipes);
-    processEntries(misc);
-
-    LogThis("Loaded " + std::to_string(CountMap.size()) + " owned unique blueprint entries.");
-}
-
-void RefreshUpgradeMap() {
-    RivenFingerprintMap.clear();
-    UpgradeMap.clear();
-
-    const auto& rawUpgrades = getValueByKey<nlohmann::json>(ReadData(DataType::Player), "RawUpgrades");
-    const auto& upgrades    = getValueByKey<nlohmann::json>(ReadData(DataType::Player), "Upgrades");
-
-    for (const auto& entry : rawUpgrades) {
-        std::string entryId   = entry.value("ItemType", "");
-        int         itemCount = entry.value("ItemCount", 0);
-        if (!entryId.empty() && itemCount > 0) {
-            UpgradeMap[entryId][0] += itemCount;
-        }
+    if (anyChanged({DataType::Images})) {
+        GameData().refreshImages();
     }
-
-    for (const auto& entry : upgrades) {
-        std::string entryId = entry.value("ItemType", "");
-        if (entryId.empty()) continue;
-
-        std::string fingerprint = entry.value("UpgradeFingerprint", "");
-        if (fingerprint.empty()) continue;
-
-        try {
-            if (fingerprint.find("\"compat\"") != std::string::npos) {
-                std::string rivenId;
-                if (entry.contains("ItemId") && entry["ItemId"].contains("$oid")) {
-                    rivenId = entry["ItemId"]["$oid"].get<std::string>();
-                } else {
-                    rivenId = entry.value("ItemId", "");
-                }
-
-                if (!rivenId.empty()) {
-                    RivenFingerprintMap.insert({rivenId, fingerprint});
-                } else {
-                    LogThis("Could not get rivenId for riven: " + entryId);
-                }
-                continue;
-            }
-
-            nlohmann::json fpJson = nlohmann::json::parse(fingerprint);
-            int lvl = fpJson.value("lvl", -1);
-            if (lvl >= 0) {
-                UpgradeMap[entryId][lvl] += 1;
-            } else {
-                LogThis("error getting level from fingerprint id: " + entryId);
-            }
-        } catch (...) {
-            LogThis("fatal error getting level from id: " + entryId);
-        }
+    //same exports as in GameDataStore::refreshNames
+    if (anyChanged({DataType::Warframes, DataType::Weapons, DataType::Sentinels,
+                    DataType::Resources, DataType::Mods, DataType::Customs})) {
+        GameData().refreshNames();
+        ClearCategoryCache();
     }
-
-    LogThis("Loaded levelled upgrades for " + std::to_string(UpgradeMap.size()) + " unique ids.");
-}
-
-
-void RefreshResultBpMap() {
-    BpToResultMap.clear();
-    ResultToBpMap.clear();
-    const auto recipes = getValueByKey<nlohmann::json>(ReadData(DataType::Blueprints), "ExportRecipes");
-    for (const auto& entry : recipes) {
-        std::string bp = entry.value("uniqueName", "");
-        std::string result = entry.value("resultType", "");
-        if (!bp.empty() && !result.empty()) {
-            BpToResultMap[bp] = result;
-            ResultToBpMap[result] = bp;
-        }
+    if (anyChanged({DataType::Blueprints})) {
+        GameData().refreshBlueprints();
     }
-    LogThis("Loaded " + std::to_string(BpToResultMap.size()) + " blueprint ↔ result mappings.");
 }
 
-void RefreshResultBpMap(const nlohmann::json& recipes) {
-    BpToResultMap.clear();
-    ResultToBpMap.clear();
-    for (const auto& entry : recipes) {
-        std::string bp = entry.value("uniqueName", "");
-        std::string result = entry.value("resultType", "");
-        if (!bp.empty() && !result.empty()) {
-            BpToResultMap[bp] = result;
-            ResultToBpMap[result] = bp;
-        }
-    }
-    LogThis("Loaded " + std::to_string(BpToResultMap.size()) + " blueprint ↔ result mappings.");
-}
-
-void RefreshXPMap() {
-    XPMap.clear();
-
-    nlohmann::json player = ReadData(DataType::Player);
-    const auto& xpArray = getValueByKey<nlohmann::json>(player, "XPInfo");
-
-    for (const auto& entry : xpArray) {
-        std::string id = entry.value("ItemType", "");
-        int xp = entry.value("XP", 0);  // default to 0 if XP is missing
+//only ever replaced as a whole on the UI thread, see ApplyInventorySnapshot
+std::shared_ptr<const InventorySnapshot> currentInventory;
 
-        if (!id.empty()) {
-            XPMap[id] = xp;
-        }
-    }
-
-    LogThis("Refreshed XPMap with " + std::to_string(XPMap.size()) + " entries.");
+void ApplyInventorySnapshot(std::shared_ptr<const InventorySnapshot> snapshot) {
+    currentInventory = std::move(snapshot);
 }
 
-int XPFromId(const std::string& id) {
-    if (XPMap.empty()) {
-        RefreshXPMap();
+const InventorySnapshot& CurrentInventory() {
+    if (!currentInventory) {
+        ApplyInventorySnapshot(BuildInventorySnapshot());
     }
+    return *currentInventory;
+}
 
-    if (auto it = XPMap.find(id); it != XPMap.end()) {
+int XPFromId(ItemId id) {
+    const auto& xp = CurrentInventory().xp;
+    if (auto it = xp.find(id); it != xp.end()) {
         return it->second;
     }
 
     return 0;
 }
 
-std::vector<RankCount> GetLevelledCounts(const std::string& id, bool refresh = false) {
-    if (UpgradeMap.empty() || refresh) {
-        RefreshUpgradeMap();
-    }
-
+std::vector<RankCount> GetLevelledCounts(ItemId id) {
+    const auto& upgrades = CurrentInventory().upgrades;
     std::vector<RankCount> result;
-    if (auto it = UpgradeMap.find(id); it != UpgradeMap.end()) {
+    if (auto it = upgrades.find(id); it != upgrades.end()) {
         for (auto& [rank, count] : it->second) {
             result.push_back(RankCount{rank, count});
         }
@@ -459,12 +382,9 @@ std::vector<RankCount> GetLevelledCounts(const std::string& id, bool refresh = f
     return result;
 }
 
-int CountFromId(const std::string& id, bool refresh = false) {
-    if (CountMap.empty() || refresh) {
-        RefreshCountMap();
-    }
-
-    if (auto bpIt = CountMap.find(id); bpIt != CountMap.end()) {
+int CountFromId(ItemId id) {
+    const auto& counts = CurrentInventory().counts;
+    if (auto bpIt = counts.find(id); bpIt != counts.end()) {
         return bpIt->second;
     }
     //LogThis("Blueprint not found! check: " + id);
@@ -472,7 +392,7 @@ int CountFromId(const std::string& id, bool refresh = false) {
 }
 
 void UpdateCounts(IModData& modData) {
-    modData.setPossessionCount(GetLevelledCounts(modData.getId()));
+    modData.setPossessionCount(GetLevelledCounts(modData.getIdHandle()));
 }
 
 std::string replaceLast(const std::string& str, const std::string& from, const std::string& to) {
@@ -481,15 +401,21 @@ std::string replaceLast(const std::string& str, const std::string& from, const s
     return str.substr(0, pos) + to + str.substr(pos + from.length());
 };
 
+//handle of the Silver/Gold/Platinum variant of a Bronze relic, NoItemId if that was never seen
+ItemId relicVariant(ItemId bronzeId, const std::string& variant) {
+    return FindId(replaceLast(IdString(bronzeId), "Bronze", variant));
+}
+
 void UpdateMastery(IData& item) {
-    int xpValue = XPFromId(item.getCraftedId());
+    int xpValue = XPFromId(item.getCraftedIdHandle());
     MasteryInfo info{};
 
+    //the stored category was computed from the crafted id already, no need to classify again
     if (xpValue > 0) {
-        info = GetMasteryLevelForItem(item.getCraftedId(), xpValue);
+        info = GetMasteryLevelForItem(item.getCraftedId(), item.getCategory(), xpValue);
     } else {
         if (!hasCategory(item.getCategory(), InventoryCategories::NoMastery)) {
-            info = GetMasteryLevelForItem(item.getCraftedId(), 0);
+            info = GetMasteryLevelForItem(item.getCraftedId(), item.getCategory(), 0);
         }
     }
 
@@ -501,31 +427,29 @@ void UpdateCounts(IDataContainer& container, bool isRelic) {
 
     IData& main = container.modifyMainData();
     UpdateMastery(main);
-    const std::string& id = main.getId();
+    const ItemId id = main.getIdHandle();
 
     if (isRelic) {
         main.setPossessionCount(Intact, CountFromId(id));
-        main.setPossessionCount(Exceptional, CountFromId(replaceLast(id, "Bronze", "Silver")));
-        main.setPossessionCount(Flawless, CountFromId(replaceLast(id, "Bronze", "Gold")));
-        main.setPossessionCount(Radiant, CountFromId(replaceLast(id, "Bronze", "Platinum")));
+        main.setPossessionCount(Exceptional, CountFromId(relicVariant(id, "Silver")));
+        main.setPossessionCount(Flawless, CountFromId(relicVariant(id, "Gold")));
+        main.setPossessionCount(Radiant, CountFromId(relicVariant(id, "Platinum")));
     } else {
-        const std::string resultId = resultFromBp(id);
+        const ItemId resultId = main.getCraftedIdHandle();
         if (resultId != id) {
             main.setPossessionCount(Blueprint, CountFromId(id));
         }
         main.setPossessionCount(Crafted, CountFromId(resultId));
     }
 
-    for (const IData* sub : container.getSubData()) {
-        if (!sub) continue;
-
-        const std::string& subId = sub->getId();
+    for (IData& sub : container.modifySubData()) {
+        const ItemId subId = sub.getIdHandle();
 
-        const std::string resultId = resultFromBp(subId);
+        const ItemId resultId = sub.getCraftedIdHandle();
         if (resultId != subId) {
-            const_cast<IData&>(*sub).setPossessionCount(Blueprint, CountFromId(subId));
+            sub.setPossessionCount(Blueprint, CountFromId(subId));
         }
-        const_cast<IData&>(*sub).setPossessionCount(Crafted, CountFromId(resultId));
+        sub.setPossessionCount(Crafted, CountFromId(resultId));
     }
 }
 
@@ -553,35 +477,29 @@ const char* CategoryToString(InventoryCategories cat) {
     }
 }
 
-std::vector<Recipe> GetRecipes()
+std::vector<Recipe> BuildRecipes()
 {
     std::vector<Recipe> recipes;
 
     LogThis("called GetRecipes()");
 
-    const auto frames = getValueByKey<nlohmann::json>(ReadData(DataType::Warframes), "ExportWarframes");
-    const auto weapons = getValueByKey<nlohmann::json>(ReadData(DataType::Weapons), "ExportWeapons");
-    const auto companions = getValueByKey<nlohmann::json>(ReadData(DataType::Sentinels), "ExportSentinels");
-    const auto blueprints = getValueByKey<nlohmann::json>(ReadData(DataType::Blueprints), "ExportRecipes");
-    RefreshResultBpMap(blueprints);
+    const auto framesData = ReadData(DataType::Warframes);
+    const auto weaponsData = ReadData(DataType::Weapons);
+    const auto companionsData = ReadData(DataType::Sentinels);
+    const auto blueprintsData = ReadData(DataType::Blueprints);
+    const auto& frames = getRefByKey(*framesData, "ExportWarframes");
+    const auto& weapons = getRefByKey(*weaponsData, "ExportWeapons");
+    const auto& companions = getRefByKey(*companionsData, "ExportSentinels");
+    const auto& blueprints = getRefByKey(*blueprintsData, "ExportRecipes");
+    const auto blueprintTable = GameData().refreshBlueprints(blueprints);
     // Prepare a combined list of all items from the three datasets
     std::vector allItems = { &frames, &weapons, &companions };
 
-    // Helper lambda to find blueprint JSON by id
-    auto findBlueprint = [blueprints](const std::string& bpId) -> const nlohmann::json* {
-        for (const auto& bp : blueprints) {
-            if (bp.contains("uniqueName") && bp["uniqueName"].is_string() && bp["uniqueName"] == bpId) {
-                return &bp;
-            }
-        }
-        return nullptr;
-    };
-
     Recipe recipe{};
     ItemData resultItem{};
-    std::string blueprintId;
+    ItemId blueprintId = NoItemId;
     ItemData ingredientItem{};
-    std::unordered_set<std::string> seenIds;
+    std::unordered_set<ItemId> seenIds;
 
     for (const auto* dataset : allItems)
     {
@@ -598,15 +516,14 @@ std::vector<Recipe> GetRecipes()
                 continue; //For some reason the khora kavat does count for mr
             }
 
-            if (seenIds.count(craftedId) > 0) {
+            const ItemId craftedHandle = InternId(craftedId);
+            if (!seenIds.insert(craftedHandle).second) {
                 LogThis("Duplicate id detected, skipping: " + craftedId);
                 continue;
             }
 
-            seenIds.insert(craftedId);
-
             // Lookup blueprint ID from craftedId
-            blueprintId = bpFromResult(craftedId);
+            blueprintId = bpFromResult(craftedHandle);
 
             if (craftedId.find("Pet") != std::string::npos &&
                 craftedId.find("Head") == std::string::npos &&
@@ -655,10 +572,10 @@ std::vector<Recipe> GetRecipes()
             }
 
             // Setup main item
-            resultItem.craftedId = craftedId;
+            resultItem.craftedId = craftedHandle;
             resultItem.id = blueprintId;
 
-            resultItem.name = nameFromId(craftedId, true);
+            resultItem.name = nameFromId(craftedHandle, true);
             if (resultItem.name.compare(0, 11, "<ARCHWING> ") == 0) {
                 resultItem.name.erase(0, 11);
             }
@@ -668,8 +585,8 @@ std::vector<Recipe> GetRecipes()
                 continue;
             }
 
-            resultItem.image = imgFromId(craftedId);
-            resultItem.category = GetItemCategoryFromId(craftedId);
+            resultItem.image = imgFromId(craftedHandle);
+            resultItem.category = GetItemCategoryFromId(craftedHandle);
 
             UpdateMastery(resultItem);
             recipe.mainItem = resultItem;
@@ -678,16 +595,11 @@ std::vector<Recipe> GetRecipes()
             recipe.subItems.clear();
 
             // If blueprint exists, load ingredients
-            if (blueprintId != craftedId) {
-                const nlohmann::json* blueprint = findBlueprint(blueprintId);
-                if (blueprint && blueprint->contains("ingredients") && (*blueprint)["ingredients"].is_array()) {
-                    for (const auto& ingredientJson : (*blueprint)["ingredients"])
+            if (blueprintId != craftedHandle) {
+                if (const BlueprintInfo* blueprint = blueprintTable->find(blueprintId)) {
+                    recipe.subItems.reserve(blueprint->ingredients.size());
+                    for (const ItemId ingredientId : blueprint->ingredients)
                     {
-                        std::string ingredientId = ingredientJson.value("ItemType", "");
-                        if (ingredientId.empty()) {
-                            continue;
-                        }
-
                         ingredientItem.id = bpFromResult(ingredientId);
                         ingredientItem.craftedId = ingredientId;
 
@@ -696,7 +608,7 @@ std::vector<Recipe> GetRecipes()
 
                         ingredientItem.category = addCategory(
                             ingredientItem.category,
-                            GetItemCategoryFromId(ingredientItem.craftedId) | InventoryCategories::Component | InventoryCategories::NoMastery
+                            GetItemCategoryFromId(ingredientId) | InventoryCategories::Component | InventoryCategories::NoMastery
                         );
 
                         recipe.subItems.push_back(ingredientItem);
@@ -714,11 +626,18 @@ std::vector<Recipe> GetRecipes()
     return recipes;
 }
 
-int GetMasteryRank() {
-    LogThis("called GetName");
-    nlohmann::json player = ReadData(DataType::Player);
-    LogThis("Parsed Player Json successfully");
-    return getValueByKey<int>(player, "PlayerLevel", 0);
+std::vector<Recipe> GetRecipes() {
+    std::vector<Recipe> recipes;
+    if (LoadSnapshot(recipes)) {
+        for (Recipe& recipe : recipes) {
+            UpdateCounts(recipe, false);
+        }
+        return recipes;
+    }
+
+    recipes = BuildRecipes();
+    SaveSnapshot(recipes);
+    return recipes;
 }
 
 std::string toTitleCase(const std::string& str) {
@@ -742,7 +661,7 @@ std::vector<std::vector<ItemData>> SplitEquipment(std::vector<Recipe> recipes)
         }
 
         // Split into prime vs normal; toTitleCase only capitalizes the very first character which is never part of 'prime'
-        if (toTitleCase(output.craftedId).find("prime") != std::string::npos) {
+        if (toTitleCase(IdString(output.craftedId)).find("prime") != std::string::npos) {
             primeItems.push_back(output);
         } else {
             normalItems.push_back(output);
@@ -752,40 +671,35 @@ std::vector<std::vector<ItemData>> SplitEquipment(std::vector<Recipe> recipes)
     return { normalItems, primeItems };
 }
 
-std::vector<MissionData> GetMissions(const json& playerJson, const json& NodesXp, const json& allNodes) {
+std::vector<MissionData> GetMissions(const std::vector<MissionProgress>& progress, const json& NodesXp, const json& allNodes) {
     LogThis("called GetMissions");
     std::vector<MissionData> missions;
     MissionData data;
 
     // Index mission completion by tag
-    std::unordered_map<std::string, json> missionDataMap;
-    json missionsJson = getValueByKey<nlohmann::json>(playerJson, "Missions");
-    for (const auto& mission : missionsJson) {
-        std::string tag = getValueByKey<std::string>(mission, "Tag");
-        if (!tag.empty()) {
-            missionDataMap[tag] = mission;
-            if (tag.find("Junction") != std::string::npos) { //Junctions wont be found in public export so handle here
-                data.tag = tag;
-                data.name = tag; //there are names for the junctions
-                size_t pos = tag.find("To", 1);
-                if (pos != std::string::npos) {
-                    data.region = tag.substr(0, pos);
-                }
-                else {
-                    data.region = tag; //fallback just make it their own region
-                }
-                data.baseXp = 1000;
-                int completes = getValueByKey<int>(mission, "Completes", 0, true);
-                int tier = getValueByKey<int>(mission, "Tier", 0, true);
-                data.isCompleted = completes > 0;
-                data.sp = (tier == 1); // Steel Path completed
-                missions.push_back(data);
+    std::unordered_map<std::string, const MissionProgress*> missionDataMap;
+    for (const MissionProgress& mission : progress) {
+        const std::string& tag = mission.tag;
+        missionDataMap[tag] = &mission;
+        if (tag.find("Junction") != std::string::npos) { //Junctions wont be found in public export so handle here
+            data.tag = tag;
+            data.name = tag; //there are names for the junctions
+            size_t pos = tag.find("To", 1);
+            if (pos != std::string::npos) {
+                data.region = tag.substr(0, pos);
+            }
+            else {
+                data.region = tag; //fallback just make it their own region
             }
+            data.baseXp = 1000;
+            data.isCompleted = mission.completes > 0;
+            data.sp = (mission.tier == 1); // Steel Path completed
+            missions.push_back(data);
         }
     }
 
     // Process all nodes from allNodes["ExportRegions"]
-    json exportRegions = getValueByKey<nlohmann::json>(allNodes, "ExportRegions");
+    const json& exportRegions = getRefByKey(allNodes, "ExportRegions");
     for (const auto& node : exportRegions) {
 
         data.tag = getValueByKey<std::string>(node, "uniqueName");
@@ -795,12 +709,10 @@ std::vector<MissionData> GetMissions(const json& playerJson, const json& NodesXp
         // Completion logic
         auto it = missionDataMap.find(data.tag);
         if (it != missionDataMap.end()) {
-            const json& m = it->second;
-            int completes = getValueByKey<int>(m, "Completes", 0, true);
-            int tier = getValueByKey<int>(m, "Tier", 0, true);
+            const MissionProgress& m = *it->second;
             //TODO: Verify if tier can be 1 and completes 0 or more concretely when it increases the tier to 1
-            data.isCompleted = completes > 0;
-            data.sp = (tier == 1); // Steel Path completed
+            data.isCompleted = m.completes > 0;
+            data.sp = (m.tier == 1); // Steel Path completed
         }
 
         // XP lookup
@@ -839,12 +751,11 @@ int GetTotalMissionXp(const std::vector<MissionData>& missions) {
     return total;
 }
 
-MissionSummary GetMissionsSummary() {
-    const json& playerJson = ReadData(DataType::Player);
-    const json& NodesXp = ReadData(DataType::Nodes);
-    const json& allNodes = ReadData(DataType::Regions);
+MissionSummary GetMissionsSummary(const std::vector<MissionProgress>& progress) {
+    const auto NodesXp = ReadData(DataType::Nodes); //TODO: solve problem: how to get new values on updates; for DataType::Nodes
+    const auto allNodes = ReadData(DataType::Regions);
     MissionSummary summary;
-    summary.missions = GetMissions(playerJson, NodesXp, allNodes);
+    summary.missions = GetMissions(progress, *NodesXp, *allNodes);
     summary.totalCount = static_cast<int>(summary.missions.size());
     summary.incompleteCount = static_cast<int>(std::count_if(
         summary.missions.begin(), summary.missions.end(),
@@ -853,55 +764,49 @@ MissionSummary GetMissionsSummary() {
     return summary;
 }
 
-int GetIntrinsicXp(const json& jsonData) {
+int GetIntrinsicXp(const std::vector<std::pair<std::string, int>>& skills) {
     int totalXp = 0;
-    json intrinsicJson = getValueByKey<nlohmann::json>(jsonData, "PlayerSkills");
-    for (auto& intrinsic : intrinsicJson.items()) {
-        int intrinsicLevel = intrinsic.value().get<int>();
+    for (const auto& [key, intrinsicLevel] : skills) {
         totalXp += intrinsicLevel * 1500;
     }
     return totalXp;
 }
 
-int extraSpecialXp = 0;
-
-int GetCurrentXP() {
-    LogThis("called GetXP");
-    nlohmann::json player = ReadData(DataType::Player);
-    LogThis("Parsed Player Json successfully");
+//'extraSpecialXp' gets the part of the total that belongs to items missing from the exports
+int CurrentXP(const InventorySnapshot& inventory, const std::vector<std::pair<std::string, int>>& skills, int& extraSpecialXp) {
     int total = 0;
     MasteryInfo info{};
     extraSpecialXp = 0;
-    const auto& xpArray = getValueByKey<nlohmann::json>(player, "XPInfo");
-    for (const auto& entry : xpArray) {
-        std::string id = entry.value("ItemType", "");
-        int xp = entry.value("XP", 0);  // Use 0 as default if "XP" missing
-
-        if (!id.empty()) {
-            info = GetMasteryLevelForItem(id, xp);
-            int toAdd = 0;
-            if (info.usedHalfAffinity) toAdd += info.level * 100;
-            else toAdd += info.level * 200;
-            total += toAdd;
-            //LogThis(id + " : " + std::to_string(toAdd));
-            if (nameFromId(id, true) == id) {
-                extraSpecialXp += toAdd;
-                LogThis("special XP not found in export: " + id);
-            }
+    for (const auto& [handle, xp] : inventory.xp) {
+        const std::string& id = IdString(handle);
+        info = GetMasteryLevelForItem(id, GetItemCategoryFromId(handle), xp);
+        int toAdd = 0;
+        if (info.usedHalfAffinity) toAdd += info.level * 100;
+        else toAdd += info.level * 200;
+        total += toAdd;
+        //LogThis(id + " : " + std::to_string(toAdd));
+        if (nameFromId(handle, true) == id) {
+            extraSpecialXp += toAdd;
+            LogThis("special XP not found in export: " + id);
         }
     }
     LogThis("parsed XPInfo for a total of " + std::to_string(total) + " Mastery Xp.");
-    std::vector<MissionData> missiondata = GetMissions(player, ReadData(DataType::Nodes), ReadData(DataType::Regions)); //TODO: solve problem: how to get new values on updates; for DataType::Nodes
-    int missionXp = GetTotalMissionXp(missiondata);
+    int missionXp = GetTotalMissionXp(inventory.missions.missions);
     total += missionXp;
     LogThis("got mission xp: " + std::to_string(missionXp));
-    int intrinsicXp = GetIntrinsicXp(player);
+    int intrinsicXp = GetIntrinsicXp(skills);
     total += intrinsicXp;
     LogThis("got Intrinsic xp: " + std::to_string(intrinsicXp));
 
     return total;
 }
 
+//display names of the intrinsic categories that are not just their key in title case
+const std::map<std::string, std::string> categoryNameMap = {
+    {"SPACE", "Railjack"},
+    {"DRIFTER", "Duviri"}
+};
+
 std::string intrinsicNameFromKey(const std::string& key, const std::string& categoryRaw) {
     std::string name = key.substr(4);
     size_t pos = name.rfind('_');
@@ -911,22 +816,22 @@ std::string intrinsicNameFromKey(const std::string& key, const std::string& cate
     return toTitleCase(name);
 }
 
-std::vector<IntrinsicCategory> GetIntrinsics() {
+std::vector<IntrinsicCategory> GetIntrinsics(const std::vector<std::pair<std::string, int>>& skills) {
     LogThis("Getting ordered Intrinsics");
-    const nlohmann::ordered_json intrinsics = getValueByKey<nlohmann::ordered_json, nlohmann::ordered_json>(ReadDataOrdered(DataType::Player), "PlayerSkills");
 
     std::vector<IntrinsicCategory> categories;
     IntrinsicCategory* currentCategory = nullptr;
     std::string categoryRaw;
 
-    for (auto& [key, value] : intrinsics.items()) {
+    //the categories are only recognizable by the order of the keys
+    for (const auto& [key, level] : skills) {
         if (key.rfind("LPP_", 0) == 0) {
             // Found a new category
             categoryRaw = key.substr(4); // strip "LPP_"
 
             IntrinsicCategory cat;
-            if (categoryNameMap.count(categoryRaw)) {
-                cat.name = categoryNameMap[categoryRaw];
+            if (auto known = categoryNameMap.find(categoryRaw); known != categoryNameMap.end()) {
+                cat.name = known->second;
             } else {
                 cat.name = toTitleCase(categoryRaw);
             }
@@ -936,7 +841,7 @@ std::vector<IntrinsicCategory> GetIntrinsics() {
         else if (key.rfind("LPS_", 0) == 0 && currentCategory) {
             Intrinsic s;
             s.name = intrinsicNameFromKey(key, categoryRaw);
-            s.level = value.get<int>();
+            s.level = level;
             //LogThis("   Added Intrinsic : " + s.name);
             currentCategory->skills.push_back(std::move(s));
         }
@@ -944,6 +849,31 @@ std::vector<IntrinsicCategory> GetIntrinsics() {
     return categories;
 }
 
+std::shared_ptr<const InventorySnapshot> BuildInventorySnapshot() {
+    LogThis("Building inventory snapshot");
+    auto snapshot = std::make_shared<InventorySnapshot>();
+    PlayerExtras extras;
+
+    //streamed, so the whole file never exists as a json tree next to the maps built from it
+    std::ifstream file(PathFromDataType(DataType::Player), std::ios::binary);
+    if (!file.is_open()) {
+        LogThis("Could not open player data");
+    } else if (ReadPlayerData(file, *snapshot, extras)) {
+        LogThis("Loaded " + std::to_string(snapshot->counts.size()) + " owned unique blueprint entries.");
+        LogThis("Loaded levelled upgrades for " + std::to_string(snapshot->upgrades.size()) + " unique ids.");
+        LogThis("Loaded XP for " + std::to_string(snapshot->xp.size()) + " entries.");
+    }
+
+    snapshot->missions = GetMissionsSummary(extras.missions);
+    snapshot->currentXp = CurrentXP(*snapshot, extras.skills, snapshot->extraSpecialXp);
+    snapshot->intrinsics = GetIntrinsics(extras.skills);
+    return snapshot;
+}
+
+void EnsureGameDataMaps() {
+    GameData().ensureLoaded();
+}
+
 Rarity parseRarity(const std::string& rarityStr) {
     if (rarityStr == "COMMON")   return Rarity::Common;
     if (rarityStr == "UNCOMMON") return Rarity::Uncommon;
@@ -952,35 +882,36 @@ Rarity parseRarity(const std::string& rarityStr) {
     return Rarity::Unknown;
 }
 
-std::vector<Relic> GetRelics() {
+std::vector<Relic> BuildRelics() {
     LogThis("called GetRelics");
-    nlohmann::json relics = getValueByKey<nlohmann::json>(ReadData(DataType::Relics), "ExportRelicArcane");
-    nlohmann::json player = ReadData(DataType::Player);
+    const auto relicData = ReadData(DataType::Relics);
+    const auto& relics = getRefByKey(*relicData, "ExportRelicArcane");
 
     std::vector<Relic> result;
     Relic relic;
     for (const auto& r : relics) {
 
         // Main item = the relic itself
-        relic.mainItem.id   = r.value("uniqueName", "");
+        const std::string relicId = r.value("uniqueName", "");
 
         // Skip any arcanes
-        if (relic.mainItem.id.rfind("/Lotus/Types/Game/Projections/", 0) != 0) {
+        if (relicId.rfind("/Lotus/Types/Game/Projections/", 0) != 0) {
             continue;
         }
 
         // Skip any relic upgrade versions
         const std::string bronzeSuffix = "Bronze";
-        if (relic.mainItem.id.size() < bronzeSuffix.size() || relic.mainItem.id.compare(relic.mainItem.id.size() - bronzeSuffix.size(), bronzeSuffix.size(), bronzeSuffix) != 0) {
+        if (relicId.size() < bronzeSuffix.size() || relicId.compare(relicId.size() - bronzeSuffix.size(), bronzeSuffix.size(), bronzeSuffix) != 0) {
             continue;
         }
 
+        relic.mainItem.id = InternId(relicId);
         relic.mainItem.name = r.value("name", "");
         relic.mainItem.image = imgFromId(relic.mainItem.id);
         relic.mainItem.possessionCounts[ItemPossessionType::Intact] = CountFromId(relic.mainItem.id);
-        relic.mainItem.possessionCounts[ItemPossessionType::Exceptional] = CountFromId(replaceLast(relic.mainItem.id, "Bronze", "Silver"));
-        relic.mainItem.possessionCounts[ItemPossessionType::Flawless] = CountFromId(replaceLast(relic.mainItem.id, "Bronze", "Gold"));
-        relic.mainItem.possessionCounts[ItemPossessionType::Radiant] = CountFromId(replaceLast(relic.mainItem.id, "Bronze", "Platinum"));
+        relic.mainItem.possessionCounts[ItemPossessionType::Exceptional] = CountFromId(relicVariant(relic.mainItem.id, "Silver"));
+        relic.mainItem.possessionCounts[ItemPossessionType::Flawless] = CountFromId(relicVariant(relic.mainItem.id, "Gold"));
+        relic.mainItem.possessionCounts[ItemPossessionType::Radiant] = CountFromId(relicVariant(relic.mainItem.id, "Platinum"));
 
         relic.mainItem.category = InventoryCategories::Relic;
         relic.mainItem.rarity = Rarity::Unknown;
@@ -991,18 +922,20 @@ std::vector<Relic> GetRelics() {
             for (const auto& reward : r["relicRewards"]) {
                 RelicData item;
 
-                item.id   = reward.value("rewardName", ""); //this for some reason adds a StoreItems/ to id which is found nowhere else
-                size_t pos = item.id .find("StoreItems/");
+                std::string rewardId = reward.value("rewardName", ""); //this for some reason adds a StoreItems/ to id which is found nowhere else
+                size_t pos = rewardId.find("StoreItems/");
                 if (pos != std::string::npos) {
-                    item.id .erase(pos, std::string("StoreItems/").length());
+                    rewardId.erase(pos, std::string("StoreItems/").length());
                 }
 
-                item.name = nameFromId(resultFromBp(item.id));
+                item.id = InternId(rewardId);
+                item.craftedId = resultFromBp(item.id);
+                item.name = nameFromId(item.craftedId);
                 item.image = imgFromId(item.id);
                 //Not sure if we will use Category for the relic rewards
-                item.category = GetItemCategoryFromId(resultFromBp(item.id));//InventoryCategories::Prime; //cant use this because we dont have crafted here: GetItemCategoryFromId(item.id);
+                item.category = GetItemCategoryFromId(item.craftedId);
                 item.possessionCounts[ItemPossessionType::Blueprint] = CountFromId(item.id);
-                item.possessionCounts[ItemPossessionType::Crafted] = CountFromId(resultFromBp(item.id));
+                item.possessionCounts[ItemPossessionType::Crafted] = CountFromId(item.craftedId);
                 item.rarity = parseRarity(reward.value("rarity", ""));
 
                 relic.subItems.push_back(std::move(item));
@@ -1015,6 +948,20 @@ std::vector<Relic> GetRelics() {
     return result;
 }
 
+std::vector<Relic> GetRelics() {
+    std::vector<Relic> relics;
+    if (LoadSnapshot(relics)) {
+        for (Relic& relic : relics) {
+            UpdateCounts(relic, true);
+        }
+        return relics;
+    }
+
+    relics = BuildRelics();
+    SaveSnapshot(relics);
+    return relics;
+}
+
 std::unordered_set<std::string> blacklistedArcanes = {
     "/Lotus/Upgrades/CosmeticEnhancers/Defensive/CorrosiveProcResist",
     "/Lotus/Upgrades/CosmeticEnhancers/Defensive/GasProcResist",
@@ -1025,10 +972,10 @@ std::unordered_set<std::string> blacklistedArcanes = {
     "/Lotus/Upgrades/CosmeticEnhancers/Utility/SlowerBleedOutOnPredeath"
 };
 
-std::vector<Arcane> GetArcanes() {
+std::vector<Arcane> BuildArcanes() {
     LogThis("called GetArcanes");
-    nlohmann::json relics = getValueByKey<nlohmann::json>(ReadData(DataType::Relics), "ExportRelicArcane");
-    nlohmann::json player = ReadData(DataType::Player);
+    const auto relicData = ReadData(DataType::Relics);
+    const auto& relics = getRefByKey(*relicData, "ExportRelicArcane");
 
     std::vector<Arcane> result;
     Arcane arcane;
@@ -1039,17 +986,18 @@ std::vector<Arcane> GetArcanes() {
         if (!r.contains("levelStats")) {
             continue;
         }
-        arcane.id   = r.value("uniqueName", "");
+        const std::string arcaneId = r.value("uniqueName", "");
 
-        if (blacklistedArcanes.find(arcane.id) != blacklistedArcanes.end()) {
+        if (blacklistedArcanes.find(arcaneId) != blacklistedArcanes.end()) {
             continue;
         }
 
         // Skip any relic
-        if (arcane.id.rfind("/Lotus/Upgrades/CosmeticEnhancers/", 0) != 0) {
+        if (arcaneId.rfind("/Lotus/Upgrades/CosmeticEnhancers/", 0) != 0) {
             continue;
         }
 
+        arcane.id = InternId(arcaneId);
         arcane.name = r.value("name", "");
         arcane.image = imgFromId(arcane.id);
         arcane.possessionCounts = GetLevelledCounts(arcane.id);
@@ -1106,19 +1054,33 @@ std::vector<Arcane> GetArcanes() {
     return result;
 }
 
-std::vector<Mod> GetMods() {
+std::vector<Arcane> GetArcanes() {
+    std::vector<Arcane> arcanes;
+    if (LoadSnapshot(arcanes)) {
+        for (Arcane& arcane : arcanes) {
+            UpdateCounts(arcane);
+        }
+        return arcanes;
+    }
+
+    arcanes = BuildArcanes();
+    SaveSnapshot(arcanes);
+    return arcanes;
+}
+
+std::vector<Mod> BuildMods() {
     LogThis("called GetMods");
-    nlohmann::json mods = getValueByKey<nlohmann::json>(ReadData(DataType::Mods), "ExportUpgrades");
-    nlohmann::json railjackMods = getValueByKey<nlohmann::json>(ReadData(DataType::Mods), "ExportAvionics");
-    nlohmann::json player = ReadData(DataType::Player);
+    const auto modData = ReadData(DataType::Mods);
+    const auto& mods = getRefByKey(*modData, "ExportUpgrades");
 
     std::vector<Mod> result;
     Mod mod;
     std::unordered_map<std::string, Arcane> arcaneMap;
     for (const auto& r : mods) {
 
-        mod.id   = r.value("uniqueName", "");
-        if (mod.id.rfind("Randomized", 0) != std::string::npos) continue; //rivens
+        const std::string modId = r.value("uniqueName", "");
+        if (modId.rfind("Randomized", 0) != std::string::npos) continue; //rivens
+        mod.id = InternId(modId);
         mod.name = r.value("name", "");
         if (mod.name == "Unfused Artifact") continue; //not sure what this is
         mod.image = imgFromId(mod.id);
@@ -1134,6 +1096,20 @@ std::vector<Mod> GetMods() {
     return result;
 }
 
+std::vector<Mod> GetMods() {
+    std::vector<Mod> mods;
+    if (LoadSnapshot(mods)) {
+        for (Mod& mod : mods) {
+            UpdateCounts(mod);
+        }
+        return mods;
+    }
+
+    mods = BuildMods();
+    SaveSnapshot(mods);
+    return mods;
+}
+
 void ResetStorage() {
 
 }
\ No newline at end of file
@@ -1,11 +1,19 @@
 #ifndef DATAREADER_H
 #define DATAREADER_H
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 #include <nlohmann/json_fwd.hpp>
 
+#include "idInterner.h"
+#include "FileAccess/FileAccess.h"
+
 enum class JsonType {
     Int,
     String,
@@ -71,6 +79,8 @@ struct IData {
 
     [[nodiscard]] virtual const std::string& getId() const = 0;
     [[nodiscard]] virtual const std::string& getCraftedId() const = 0;
+    [[nodiscard]] virtual ItemId getIdHandle() const = 0;
+    [[nodiscard]] virtual ItemId getCraftedIdHandle() const = 0;
     [[nodiscard]] virtual const std::string& getName() const = 0;
     [[nodiscard]] virtual const std::string& getImage() const = 0;
     [[nodiscard]] virtual InventoryCategories getCategory() const = 0;
@@ -84,6 +94,7 @@ struct IModData {
     virtual ~IModData() = default;
 
     [[nodiscard]] virtual const std::string& getId() const = 0;
+    [[nodiscard]] virtual ItemId getIdHandle() const = 0;
     [[nodiscard]] virtual const std::string& getName() const = 0;
     [[nodiscard]] virtual const std::string& getImage() const = 0;
     [[nodiscard]] virtual InventoryCategories getCategory() const = 0;
@@ -93,30 +104,82 @@ struct IModData {
     virtual void setPossessionCount(std::vector<RankCount> newCounts) = 0;
 };
 
+// Non-owning view over the sub-items of a container, whatever their concrete type. It only points into the
+// container's own vector, so handing one out allocates and writes nothing and any number of threads can
+// walk the same container at once. Invalidated like an iterator of that vector.
+template<typename Base> //const IData or IData
+class SubItemSpan {
+    using Items = std::conditional_t<std::is_const_v<Base>, const void*, void*>;
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<Base>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Base*;
+        using reference = Base&;
+
+        iterator() = default;
+        iterator(const SubItemSpan* span, size_t index) : span(span), index(index) {}
+
+        reference operator*() const { return (*span)[index]; }
+        pointer operator->() const { return &(*span)[index]; }
+        iterator& operator++() { ++index; return *this; }
+        iterator operator++(int) { iterator old = *this; ++index; return old; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+
+    private:
+        const SubItemSpan* span = nullptr;
+        size_t index = 0;
+    };
+
+    SubItemSpan() = default;
+
+    template<typename T> requires std::is_convertible_v<T*, Base*>
+    SubItemSpan(T* data, size_t count) : items(data), count(count), at(&At<T>) {}
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    Base& operator[](size_t i) const { return at(items, i); }
+    [[nodiscard]] iterator begin() const { return {this, 0}; }
+    [[nodiscard]] iterator end() const { return {this, count}; }
+
+private:
+    template<typename T>
+    static Base& At(Items data, size_t i) { return static_cast<T*>(data)[i]; }
+
+    Items items = nullptr;
+    size_t count = 0;
+    Base& (*at)(Items, size_t) = nullptr;
+};
+
 struct IDataContainer {
     virtual ~IDataContainer() = default;
 
     [[nodiscard]] virtual const IData& getMainData() const = 0;
     [[nodiscard]] virtual IData& modifyMainData() = 0;
-    // Warning: getSubData() is not thread-safe and uses a static buffer internally
-    [[nodiscard]] virtual const std::vector<const IData*>& getSubData() const = 0;
+    [[nodiscard]] virtual SubItemSpan<const IData> getSubData() const = 0;
+    [[nodiscard]] virtual SubItemSpan<IData> modifySubData() = 0;
 };
 
 struct ItemData : IData{
-    std::string id{};
-    std::string craftedId{};
+    ItemId id = NoItemId;
+    ItemId craftedId = NoItemId;
     std::string name{};
-    std::string image{};
+    ItemId image = NoItemId;
     MasteryInfo info = {};
     bool mastered = false;
     std::unordered_map<ItemPossessionType, int> possessionCounts;
     InventoryCategories category{};
 
     // Implement IData
-    [[nodiscard]] const std::string& getId() const override { return id; }
-    [[nodiscard]] const std::string& getCraftedId() const override { return craftedId; }
+    [[nodiscard]] const std::string& getId() const override { return IdString(id); }
+    [[nodiscard]] const std::string& getCraftedId() const override { return IdString(craftedId); }
+    [[nodiscard]] ItemId getIdHandle() const override { return id; }
+    [[nodiscard]] ItemId getCraftedIdHandle() const override { return craftedId; }
     [[nodiscard]] const std::string& getName() const override { return name; }
-    [[nodiscard]] const std::string& getImage() const override { return image; }
+    [[nodiscard]] const std::string& getImage() const override { return IdString(image); }
     [[nodiscard]] InventoryCategories getCategory() const override { return category; }
     [[nodiscard]] const bool& getMastered() const override { return mastered; }
     [[nodiscard]] const std::unordered_map<ItemPossessionType, int>& getPossessionCounts() const override { return possessionCounts; }
@@ -131,8 +194,6 @@ struct ItemData : IData{
     }
 };
 
-static std::vector<const IData*> IDataTmp;
-
 struct Recipe : IDataContainer {
     ItemData mainItem{};
     std::vector<ItemData> subItems;
@@ -142,31 +203,32 @@ struct Recipe : IDataContainer {
 
     [[nodiscard]] IData& modifyMainData() override { return mainItem; }
 
-    [[nodiscard]] const std::vector<const IData*>& getSubData() const override {
+    [[nodiscard]] SubItemSpan<const IData> getSubData() const override {
+        return {subItems.data(), subItems.size()};
+    }
 
-        IDataTmp.clear();
-        for (const auto& s : subItems) {
-            IDataTmp.push_back(&s);
-        }
-        return IDataTmp;
+    [[nodiscard]] SubItemSpan<IData> modifySubData() override {
+        return {subItems.data(), subItems.size()};
     }
 };
 
-//TODO: dont Relics sub items also need craftedid? or should have
 struct RelicData : IData{
-    std::string id{};
+    ItemId id = NoItemId;
+    ItemId craftedId = NoItemId; //result of the reward blueprint; same as id for the relic itself
     std::string name{};
-    std::string image{};
+    ItemId image = NoItemId;
     bool mastered = false; //this is always false; just triggers the symbol for the view Widget; Maybe favourite?
     std::unordered_map<ItemPossessionType, int> possessionCounts;
     InventoryCategories category{};
     Rarity rarity{Rarity::Unknown};
 
     // Implement IData
-    [[nodiscard]] const std::string& getId() const override { return id; }
-    [[nodiscard]] const std::string& getCraftedId() const override { return id; } //just has no crafted variant
+    [[nodiscard]] const std::string& getId() const override { return IdString(id); }
+    [[nodiscard]] const std::string& getCraftedId() const override { return IdString(getCraftedIdHandle()); }
+    [[nodiscard]] ItemId getIdHandle() const override { return id; }
+    [[nodiscard]] ItemId getCraftedIdHandle() const override { return craftedId == NoItemId ? id : craftedId; }
     [[nodiscard]] const std::string& getName() const override { return name; }
-    [[nodiscard]] const std::string& getImage() const override { return image; }
+    [[nodiscard]] const std::string& getImage() const override { return IdString(image); }
     [[nodiscard]] InventoryCategories getCategory() const override { return category; }
     [[nodiscard]] const bool& getMastered() const override { return mastered; }
     [[nodiscard]] const std::unordered_map<ItemPossessionType, int>& getPossessionCounts() const override { return possessionCounts; }
@@ -189,28 +251,29 @@ struct Relic : IDataContainer {
 
     [[nodiscard]] IData& modifyMainData() override { return mainItem; }
 
-    [[nodiscard]] const std::vector<const IData*>& getSubData() const override {
-        IDataTmp.clear();
-        for (const auto& s : subItems) {
-            IDataTmp.push_back(&s);
-        }
-        return IDataTmp;
+    [[nodiscard]] SubItemSpan<const IData> getSubData() const override {
+        return {subItems.data(), subItems.size()};
+    }
+
+    [[nodiscard]] SubItemSpan<IData> modifySubData() override {
+        return {subItems.data(), subItems.size()};
     }
 };
 
 struct Arcane : IModData {
-    std::string id{};
+    ItemId id = NoItemId;
     std::string name{};
-    std::string image{};
+    ItemId image = NoItemId;
     std::vector<RankCount> possessionCounts;
     InventoryCategories category{};
     Rarity rarity{Rarity::Unknown};
     std::vector<std::string> stats{};
 
     // Implement IData
-    [[nodiscard]] const std::string& getId() const override { return id; }
+    [[nodiscard]] const std::string& getId() const override { return IdString(id); }
+    [[nodiscard]] ItemId getIdHandle() const override { return id; }
     [[nodiscard]] const std::string& getName() const override { return name; }
-    [[nodiscard]] const std::string& getImage() const override { return image; }
+    [[nodiscard]] const std::string& getImage() const override { return IdString(image); }
     [[nodiscard]] InventoryCategories getCategory() const override { return category; }
     [[nodiscard]] Rarity getRarity() const override { return rarity; }
     [[nodiscard]] const std::vector<RankCount>& getPossessionCounts() const override { return possessionCounts; }
@@ -221,9 +284,9 @@ struct Arcane : IModData {
 };
 
 struct Mod : IModData {
-    std::string id{};
+    ItemId id = NoItemId;
     std::string name{};
-    std::string image{};
+    ItemId image = NoItemId;
     std::vector<RankCount> possessionCounts;
     InventoryCategories category{};
     Rarity rarity{Rarity::Unknown};
@@ -231,9 +294,10 @@ struct Mod : IModData {
     int fusionLimit = 0;
 
     // Implement IData
-    [[nodiscard]] const std::string& getId() const override { return id; }
+    [[nodiscard]] const std::string& getId() const override { return IdString(id); }
+    [[nodiscard]] ItemId getIdHandle() const override { return id; }
     [[nodiscard]] const std::string& getName() const override { return name; }
-    [[nodiscard]] const std::string& getImage() const override { return image; }
+    [[nodiscard]] const std::string& getImage() const override { return IdString(image); }
     [[nodiscard]] InventoryCategories getCategory() const override { return category; }
     [[nodiscard]] Rarity getRarity() const override { return rarity; }
     [[nodiscard]] const std::vector<RankCount>& getPossessionCounts() const override { return possessionCounts; }
@@ -268,21 +332,6 @@ struct IntrinsicCategory {
     std::vector<Intrinsic> skills;
 };
 
-static std::map<std::string, std::string> categoryNameMap = {
-    {"SPACE", "Railjack"},
-    {"DRIFTER", "Duviri"}
-};
-
-static std::unordered_map<std::string, std::string> ImgMap;
-static std::unordered_map<std::string, std::string> NameMap;
-static std::unordered_map<std::string, int> CountMap;
-static std::unordered_map<std::string, std::string> BpToResultMap;
-static std::unordered_map<std::string, std::string> ResultToBpMap;
-static std::unordered_map<std::string, std::map<int,int>> UpgradeMap;
-static std::unordered_map<std::string, std::string> RivenFingerprintMap;
-static std::unordered_map<std::string, int> XPMap;
-extern int extraSpecialXp;
-
 // Bitwise OR
 InventoryCategories operator|(InventoryCategories lhs, InventoryCategories rhs);
 
@@ -304,29 +353,42 @@ InventoryCategories addCategory(InventoryCategories value, InventoryCategories c
 // Return 'value' with 'category' unset
 InventoryCategories unsetCategory(InventoryCategories value, InventoryCategories category);
 
-int GetMasteryRank();
-int GetCurrentXP();
-MissionSummary GetMissionsSummary();
-std::vector<IntrinsicCategory> GetIntrinsics();
 std::vector<std::vector<ItemData>> SplitEquipment(std::vector<Recipe> recipes);
 std::vector<Recipe> GetRecipes();
 std::vector<Relic> GetRelics();
 std::vector<Arcane> GetArcanes();
 std::vector<Mod> GetMods();
 
-//game relevant
-void RefreshImgMap();
-void RefreshNameMap();
-void RefreshResultBpMap();
+//game relevant, the lookups themselves live in GameData()
+void RefreshGameDataMaps(const std::vector<DataType>& changed); //only the maps built from 'changed'
 std::string imgFromId(const std::string& id);
 
 //player relevant
-void RefreshCountMap();
-void RefreshUpgradeMap();
-void RefreshXPMap();
+// Everything derived from player_data.json. BuildInventorySnapshot only reads files and the game data
+// lookups, so a sync can build it on a worker thread; the finished snapshot never changes and is swapped
+// in as a whole on the UI thread, where UpdateCounts and the overview read from it.
+struct InventorySnapshot {
+    std::unordered_map<ItemId, int> counts; //Recipes + MiscItems
+    std::unordered_map<ItemId, std::map<int, int>> upgrades; //rank -> count
+    std::unordered_map<std::string, std::string> rivenFingerprints; //keyed by the riven's ItemId.$oid
+    std::unordered_map<ItemId, int> xp;
+
+    int masteryRank = 0;
+    int currentXp = 0;
+    int extraSpecialXp = 0; //xp of items that are not in the exports, like the plexus
+    MissionSummary missions;
+    std::vector<IntrinsicCategory> intrinsics;
+};
+
+std::shared_ptr<const InventorySnapshot> BuildInventorySnapshot();
+void ApplyInventorySnapshot(std::shared_ptr<const InventorySnapshot> snapshot); //UI thread only
+const InventorySnapshot& CurrentInventory(); //builds one right away if none was applied yet
+
+//loads the game data maps that were not needed yet; call on the UI thread before handing work to another
+//thread, so that thread never triggers a lazy refresh itself
+void EnsureGameDataMaps();
 
 void UpdateCounts(IDataContainer& container, bool isRelic);
 void UpdateCounts(IModData& modData);
-int GetExtraSpecialXp();
 
 #endif //DATAREADER_H
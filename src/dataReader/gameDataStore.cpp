@@ -0,0 +1,183 @@
+#include "gameDataStore.h"
+
+#include "FileAccess/FileAccess.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+//fills 'result' with uniqueName -> interned valueKey for every entry of j[arrayKey]; returns the number of entries read
+size_t extractMapFromArray(
+    const json& j,
+    const std::string& arrayKey,
+    std::unordered_map<ItemId, ItemId>& result,
+    const std::string& valueKey = "name")
+{
+    // Check if arrayKey exists and is an array
+    auto arrIt = j.find(arrayKey);
+    if (arrIt == j.end() || !arrIt->is_array()) return 0;
+
+    size_t count = 0;
+    for (const auto& entry : *arrIt) {
+        std::string id = entry.value("uniqueName", "");
+        if (!id.empty()) {
+            result[InternId(id)] = InternId(entry.value(valueKey, ""));
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+ItemId FindOr(const std::unordered_map<ItemId, ItemId>& map, ItemId id) {
+    auto it = map.find(id);
+    return it != map.end() ? it->second : NoItemId;
+}
+
+std::unique_ptr<const ImageTable> BuildImageTable() {
+    auto table = std::make_unique<ImageTable>();
+    const auto manifest = ReadData(DataType::Images);
+    extractMapFromArray(*manifest, "Manifest", table->images, "textureLocation");
+    LogThis("Loaded " + std::to_string(table->images.size()) + " image entries.");
+    return table;
+}
+
+std::unique_ptr<const NameTable> BuildNameTable() {
+    auto table = std::make_unique<NameTable>();
+    auto& names = table->names;
+    const auto frames = ReadData(DataType::Warframes);
+    const auto weapons = ReadData(DataType::Weapons);
+    const auto companions = ReadData(DataType::Sentinels);
+    const auto resources = ReadData(DataType::Resources);
+    const auto mods = ReadData(DataType::Mods);
+    const auto custom = ReadData(DataType::Customs);
+
+    LogThis("Loaded " + std::to_string(extractMapFromArray(*frames, "ExportWarframes", names)) + " warframe entries.");
+    LogThis("Loaded " + std::to_string(extractMapFromArray(*weapons, "ExportWeapons", names)) + " weapon entries.");
+    LogThis("Loaded " + std::to_string(extractMapFromArray(*companions, "ExportSentinels", names)) + " companion entries.");
+    LogThis("Loaded " + std::to_string(extractMapFromArray(*resources, "ExportResources", names)) + " component entries.");
+    LogThis("Loaded " + std::to_string(extractMapFromArray(*mods, "ExportUpgrades", names)) + " mod entries.");
+    LogThis("Loaded " + std::to_string(extractMapFromArray(*custom, "ExportCustoms", names)) + " custom entries.");
+    return table;
+}
+
+std::unique_ptr<const BlueprintTable> BuildBlueprintTable(const json& recipes) {
+    auto table = std::make_unique<BlueprintTable>();
+    table->blueprints.reserve(recipes.size());
+    for (const auto& entry : recipes) {
+        const ItemId bp = InternId(entry.value("uniqueName", ""));
+        const ItemId result = InternId(entry.value("resultType", ""));
+        if (bp == NoItemId) continue;
+
+        //first entry wins, same as the old linear search did
+        auto [it, inserted] = table->blueprints.try_emplace(bp);
+        if (inserted) {
+            it->second.resultId = result;
+            if (auto ingredients = entry.find("ingredients"); ingredients != entry.end() && ingredients->is_array()) {
+                it->second.ingredients.reserve(ingredients->size());
+                for (const auto& ingredientJson : *ingredients) {
+                    const ItemId ingredientId = InternId(ingredientJson.value("ItemType", ""));
+                    if (ingredientId != NoItemId) {
+                        it->second.ingredients.push_back(ingredientId);
+                    }
+                }
+            }
+        }
+
+        if (result != NoItemId) {
+            table->bpToResult[bp] = result;
+            table->resultToBp[result] = bp;
+        }
+    }
+    LogThis("Loaded " + std::to_string(table->bpToResult.size()) + " blueprint ↔ result mappings.");
+    return table;
+}
+
+std::unique_ptr<const BlueprintTable> BuildBlueprintTable() {
+    const auto data = ReadData(DataType::Blueprints);
+    auto recipes = data->find("ExportRecipes");
+    if (recipes == data->end()) {
+        LogThis("Key not found: ExportRecipes");
+        return BuildBlueprintTable(json::array());
+    }
+    return BuildBlueprintTable(*recipes);
+}
+
+} // namespace
+
+const BlueprintInfo* BlueprintTable::find(ItemId blueprint) const {
+    auto it = blueprints.find(blueprint);
+    return it != blueprints.end() ? &it->second : nullptr;
+}
+
+GameDataStore& GameData() {
+    static GameDataStore store;
+    return store;
+}
+
+//the published table, built first if nobody needed it yet
+template<typename Table>
+const Table* GameDataStore::current(std::atomic<const Table*>& slot, std::unique_ptr<const Table> (*build)()) {
+    if (const Table* table = slot.load(std::memory_order_acquire)) return table;
+
+    std::lock_guard lock(buildMutex);
+    if (const Table* table = slot.load(std::memory_order_acquire)) return table; //someone else was faster
+    return publish(slot, build());
+}
+
+//the table it replaces stays in 'tables', readers may still be looking at it
+template<typename Table>
+const Table* GameDataStore::publish(std::atomic<const Table*>& slot, std::unique_ptr<const Table> table) {
+    const Table* published = table.get();
+    tables.emplace_back(std::move(table));
+    slot.store(published, std::memory_order_release);
+    return published;
+}
+
+ItemId GameDataStore::image(ItemId id) {
+    return FindOr(current(imageTable, BuildImageTable)->images, id);
+}
+
+const std::string* GameDataStore::name(ItemId id) {
+    const NameTable* table = current(nameTable, BuildNameTable);
+    auto it = table->names.find(id);
+    return it != table->names.end() ? &IdString(it->second) : nullptr;
+}
+
+ItemId GameDataStore::resultOf(ItemId blueprint) {
+    return FindOr(current(blueprintTable, BuildBlueprintTable)->bpToResult, blueprint);
+}
+
+ItemId GameDataStore::blueprintOf(ItemId result) {
+    return FindOr(current(blueprintTable, BuildBlueprintTable)->resultToBp, result);
+}
+
+const BlueprintTable* GameDataStore::blueprints() {
+    return current(blueprintTable, BuildBlueprintTable);
+}
+
+void GameDataStore::refreshImages() {
+    std::lock_guard lock(buildMutex);
+    publish(imageTable, BuildImageTable());
+}
+
+void GameDataStore::refreshNames() {
+    std::lock_guard lock(buildMutex);
+    publish(nameTable, BuildNameTable());
+}
+
+void GameDataStore::refreshBlueprints() {
+    std::lock_guard lock(buildMutex);
+    publish(blueprintTable, BuildBlueprintTable());
+}
+
+const BlueprintTable* GameDataStore::refreshBlueprints(const json& recipes) {
+    std::lock_guard lock(buildMutex);
+    return publish(blueprintTable, BuildBlueprintTable(recipes));
+}
+
+void GameDataStore::ensureLoaded() {
+    current(imageTable, BuildImageTable);
+    current(nameTable, BuildNameTable);
+    current(blueprintTable, BuildBlueprintTable);
+}
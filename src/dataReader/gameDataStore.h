@@ -0,0 +1,74 @@
+#ifndef GAMEDATASTORE_H
+#define GAMEDATASTORE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "idInterner.h"
+
+//parsed ExportRecipes entry, indexed by the blueprint uniqueName
+struct BlueprintInfo {
+    ItemId resultId = NoItemId;
+    std::vector<ItemId> ingredients; //ItemType of every ingredient, in export order
+};
+
+//all keyed by interned uniqueName, see idInterner.h; a published table never changes again
+struct ImageTable {
+    std::unordered_map<ItemId, ItemId> images; //textureLocation
+};
+
+struct NameTable {
+    std::unordered_map<ItemId, ItemId> names; //interned too, so IdString keeps them valid after a refresh
+};
+
+struct BlueprintTable {
+    std::unordered_map<ItemId, ItemId> bpToResult;
+    std::unordered_map<ItemId, ItemId> resultToBp;
+    std::unordered_map<ItemId, BlueprintInfo> blueprints;
+
+    [[nodiscard]] const BlueprintInfo* find(ItemId blueprint) const; //nullptr if unknown
+};
+
+// The lookups built from the game exports, held exactly once for the whole program (see GameData()).
+// Every part is an immutable table published through an atomic pointer: a refresh builds the replacement on
+// the side and publishes it with one store, a lookup is a single acquire load and never waits or writes.
+// Replaced tables are not freed but retired, the store owns them until the program exits, so a pointer a
+// reader got stays valid no matter how many refreshes happen meanwhile. Refreshes only follow a game update,
+// the few old tables kept that way are cheaper than tracking their readers.
+// A part is built on its first lookup; builds are serialized, so the exports behind it are read once no
+// matter how many threads ask at the same time.
+class GameDataStore {
+public:
+    ItemId image(ItemId id);       //NoItemId if unknown
+    const std::string* name(ItemId id); //nullptr if unknown, never dangles since names are interned
+    ItemId resultOf(ItemId blueprint); //NoItemId if unknown
+    ItemId blueprintOf(ItemId result); //NoItemId if unknown
+    const BlueprintTable* blueprints(); //valid until the program exits, also after a refresh
+
+    void refreshImages();     //ExportManifest
+    void refreshNames();      //ExportWarframes, Weapons, Sentinels, Resources, Upgrades, Customs
+    void refreshBlueprints(); //ExportRecipes
+    const BlueprintTable* refreshBlueprints(const nlohmann::json& recipes); //for callers holding ExportRecipes
+    void ensureLoaded();      //builds the parts that were not needed yet
+
+private:
+    template<typename Table>
+    const Table* current(std::atomic<const Table*>& slot, std::unique_ptr<const Table> (*build)());
+    template<typename Table>
+    const Table* publish(std::atomic<const Table*>& slot, std::unique_ptr<const Table> table); //buildMutex held
+
+    std::mutex buildMutex; //only between builders, lookups never take it
+    std::atomic<const ImageTable*> imageTable{nullptr};
+    std::atomic<const NameTable*> nameTable{nullptr};
+    std::atomic<const BlueprintTable*> blueprintTable{nullptr};
+    std::vector<std::shared_ptr<const void>> tables; //every table ever published, current and retired; buildMutex
+};
+
+GameDataStore& GameData(); //created on first use, lives until the program exits
+
+#endif //GAMEDATASTORE_H
@@ -0,0 +1,87 @@
+#include "idInterner.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+// Strings live in fixed size chunks that are never moved, so IdString() can index them without a
+// lock: a chunk pointer is always written before any handle pointing into it is handed out.
+constexpr size_t chunkBits = 12;
+constexpr size_t chunkSize = size_t{1} << chunkBits;
+constexpr size_t maxChunks = 1024; //~4M distinct strings, a full export set is around 100k
+
+std::array<std::unique_ptr<std::string[]>, maxChunks> chunks;
+size_t usedCount = 0;
+
+std::unordered_map<std::string_view, ItemId> lookup; //views point into the chunks above
+std::shared_mutex internMutex;
+
+std::string& Slot(ItemId id) {
+    return chunks[id >> chunkBits][id & (chunkSize - 1)];
+}
+
+//caller holds the unique lock
+ItemId Append(std::string_view value) {
+    if (usedCount == maxChunks * chunkSize) {
+        throw std::runtime_error("ItemId interner is full");
+    }
+    const auto id = static_cast<ItemId>(usedCount);
+    if (!chunks[id >> chunkBits]) {
+        chunks[id >> chunkBits] = std::make_unique<std::string[]>(chunkSize);
+    }
+    std::string& slot = Slot(id);
+    slot.assign(value);
+    lookup.emplace(slot, id);
+    ++usedCount;
+    return id;
+}
+
+//makes sure handle 0 is the empty string before anything else gets interned
+bool InitEmpty() {
+    std::unique_lock lock(internMutex);
+    if (usedCount == 0) Append({});
+    return true;
+}
+
+} // namespace
+
+ItemId InternId(std::string_view id) {
+    static const bool initialized = InitEmpty();
+    (void)initialized;
+    {
+        std::shared_lock lock(internMutex);
+        if (auto it = lookup.find(id); it != lookup.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(internMutex);
+    if (auto it = lookup.find(id); it != lookup.end()) { //someone else added it in between
+        return it->second;
+    }
+    return Append(id);
+}
+
+ItemId FindId(std::string_view id) {
+    std::shared_lock lock(internMutex);
+    if (auto it = lookup.find(id); it != lookup.end()) {
+        return it->second;
+    }
+    return NoItemId;
+}
+
+const std::string& IdString(ItemId id) {
+    static const std::string empty;
+    if (id == NoItemId || !chunks[id >> chunkBits]) return empty;
+    return Slot(id);
+}
+
+size_t InternedIdCount() {
+    std::shared_lock lock(internMutex);
+    return usedCount;
+}
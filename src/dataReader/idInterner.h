@@ -0,0 +1,27 @@
+#ifndef IDINTERNER_H
+#define IDINTERNER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Process wide interner for the long '/Lotus/...' uniqueNames (and image paths).
+// Every distinct string is stored exactly once and gets a compact handle that all lookup maps
+// and item structs use instead of another std::string copy. Handles are never freed.
+using ItemId = uint32_t;
+
+// Handle of the empty string; also returned by FindId() for strings that were never interned
+constexpr ItemId NoItemId = 0;
+
+// Returns the handle for 'id', adding it if it was not seen before
+ItemId InternId(std::string_view id);
+
+// Returns the handle for 'id' or NoItemId without adding anything
+ItemId FindId(std::string_view id);
+
+// Lock free; the reference stays valid for the whole program runtime
+const std::string& IdString(ItemId id);
+
+size_t InternedIdCount();
+
+#endif //IDINTERNER_H
@@ -0,0 +1,73 @@
+#include "keywordMatcher.h"
+
+#include <queue>
+#include <stdexcept>
+
+KeywordMatcher::KeywordMatcher(const std::vector<std::string_view>& keywords) {
+    if (keywords.size() > 64) {
+        throw std::invalid_argument("KeywordMatcher supports at most 64 keywords");
+    }
+
+    for (std::string_view keyword : keywords) {
+        for (unsigned char c : keyword) {
+            if (byteClass[c] == 0) {
+                byteClass[c] = static_cast<uint8_t>(classCount++);
+            }
+        }
+    }
+
+    // build the trie; -1 marks a missing edge until the failure links fill it in
+    transitions.assign(classCount, -1);
+    outputs.assign(1, 0);
+    for (size_t i = 0; i < keywords.size(); ++i) {
+        int32_t node = 0;
+        for (unsigned char c : keywords[i]) {
+            const size_t edge = node * classCount + byteClass[c];
+            if (transitions[edge] == -1) {
+                transitions[edge] = static_cast<int32_t>(outputs.size());
+                transitions.resize(transitions.size() + classCount, -1);
+                outputs.push_back(0);
+            }
+            node = transitions[edge];
+        }
+        outputs[node] |= uint64_t{1} << i;
+    }
+
+    // breadth first over the trie to turn it into a complete automaton
+    std::vector<int32_t> fail(outputs.size(), 0);
+    std::queue<int32_t> pending;
+    for (size_t c = 0; c < classCount; ++c) {
+        int32_t& next = transitions[c];
+        if (next == -1) {
+            next = 0;
+        } else {
+            fail[next] = 0;
+            pending.push(next);
+        }
+    }
+    while (!pending.empty()) {
+        const int32_t node = pending.front();
+        pending.pop();
+        outputs[node] |= outputs[fail[node]];
+        for (size_t c = 0; c < classCount; ++c) {
+            int32_t& next = transitions[node * classCount + c];
+            const int32_t viaFail = transitions[fail[node] * classCount + c];
+            if (next == -1) {
+                next = viaFail;
+            } else {
+                fail[next] = viaFail;
+                pending.push(next);
+            }
+        }
+    }
+}
+
+uint64_t KeywordMatcher::match(std::string_view text) const {
+    uint64_t found = 0;
+    int32_t node = 0;
+    for (unsigned char c : text) {
+        node = transitions[node * classCount + byteClass[c]];
+        found |= outputs[node];
+    }
+    return found;
+}
@@ -0,0 +1,27 @@
+#ifndef KEYWORDMATCHER_H
+#define KEYWORDMATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Aho-Corasick automaton over a fixed list of up to 64 keywords.
+// match() walks the text once and returns a bitmask with bit i set if keywords[i] occurs anywhere in it,
+// which replaces one std::string::find per keyword.
+class KeywordMatcher {
+public:
+    explicit KeywordMatcher(const std::vector<std::string_view>& keywords);
+
+    [[nodiscard]] uint64_t match(std::string_view text) const;
+
+private:
+    // bytes that do not appear in any keyword share class 0, keeps the transition table small
+    std::array<uint8_t, 256> byteClass{};
+    size_t classCount = 1;
+
+    std::vector<int32_t> transitions; // node * classCount + class -> next node (complete DFA)
+    std::vector<uint64_t> outputs;    // keywords ending at a node, including its suffix links
+};
+
+#endif //KEYWORDMATCHER_H
@@ -0,0 +1,339 @@
+#include "playerReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <nlohmann/json.hpp>
+
+#include "dataReader.h"
+#include "FileAccess/FileAccess.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+bool IsJsonSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+size_t SkipSpace(std::string_view text, size_t pos) {
+    while (pos < text.size() && IsJsonSpace(text[pos])) ++pos;
+    return pos;
+}
+
+// Fast path of FingerprintLevel. Only tracks nesting and string boundaries, which is enough to find the
+// top level "lvl" key; returns nullopt for everything it does not fully understand.
+std::optional<int> ScanFingerprintLevel(std::string_view text) {
+    size_t pos = SkipSpace(text, 0);
+    if (pos == text.size() || text[pos] != '{') return std::nullopt;
+
+    std::optional<int> level;
+    int depth = 0;
+    while (pos < text.size()) {
+        const char c = text[pos];
+        if (c == '"') {
+            const size_t start = ++pos;
+            while (pos < text.size() && text[pos] != '"') {
+                pos += text[pos] == '\\' ? 2 : 1;
+            }
+            if (pos >= text.size()) return std::nullopt;
+            const std::string_view str = text.substr(start, pos - start);
+            ++pos;
+            if (depth != 1 || str != "lvl") continue;
+
+            size_t valuePos = SkipSpace(text, pos);
+            if (valuePos == text.size() || text[valuePos] != ':') continue; //a string value, not the key
+            valuePos = SkipSpace(text, valuePos + 1);
+
+            const bool negative = valuePos < text.size() && text[valuePos] == '-';
+            if (negative) ++valuePos;
+            const size_t digitsStart = valuePos;
+            int value = 0;
+            while (valuePos < text.size() && text[valuePos] >= '0' && text[valuePos] <= '9') {
+                if (valuePos - digitsStart == 9) return std::nullopt; //would overflow, let the parser decide
+                value = value * 10 + (text[valuePos] - '0');
+                ++valuePos;
+            }
+            const size_t digits = valuePos - digitsStart;
+            if (digits == 0 || (digits > 1 && text[digitsStart] == '0')) return std::nullopt;
+            if (valuePos < text.size() && (text[valuePos] == '.' || text[valuePos] == 'e' || text[valuePos] == 'E')) {
+                return std::nullopt;
+            }
+            level = negative ? -value : value; //keep scanning, with duplicate keys the last one wins
+            pos = valuePos;
+            continue;
+        }
+
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0) {
+                ++pos;
+                break;
+            }
+        }
+        ++pos;
+    }
+
+    if (depth != 0 || SkipSpace(text, pos) != text.size()) return std::nullopt;
+    return level;
+}
+
+// top level keys of player_data.json we read, everything else is skipped event by event
+enum class Section { Other, PlayerLevel, Recipes, MiscItems, RawUpgrades, Upgrades, XPInfo, Missions, PlayerSkills };
+
+// keys inside one element of the section arrays
+enum class Field { Other, ItemType, ItemCount, XP, UpgradeFingerprint, ItemId, Oid, Tag, Completes, Tier };
+
+Section SectionFromKey(const std::string& key) {
+    if (key == "PlayerLevel")  return Section::PlayerLevel;
+    if (key == "Recipes")      return Section::Recipes;
+    if (key == "MiscItems")    return Section::MiscItems;
+    if (key == "RawUpgrades")  return Section::RawUpgrades;
+    if (key == "Upgrades")     return Section::Upgrades;
+    if (key == "XPInfo")       return Section::XPInfo;
+    if (key == "Missions")     return Section::Missions;
+    if (key == "PlayerSkills") return Section::PlayerSkills;
+    return Section::Other;
+}
+
+Field FieldFromKey(const std::string& key) {
+    if (key == "ItemType")           return Field::ItemType;
+    if (key == "ItemCount")          return Field::ItemCount;
+    if (key == "XP")                 return Field::XP;
+    if (key == "UpgradeFingerprint") return Field::UpgradeFingerprint;
+    if (key == "ItemId")             return Field::ItemId;
+    if (key == "Tag")                return Field::Tag;
+    if (key == "Completes")          return Field::Completes;
+    if (key == "Tier")               return Field::Tier;
+    return Field::Other;
+}
+
+//the fields we keep are ints; a number outside their range sticks to the nearest end, NaN counts as 0
+int ClampToInt(json::number_integer_t value) {
+    return static_cast<int>(std::clamp<json::number_integer_t>(value, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+}
+
+int ClampToInt(json::number_unsigned_t value) {
+    return static_cast<int>(std::min<json::number_unsigned_t>(value, std::numeric_limits<int>::max()));
+}
+
+int ClampToInt(json::number_float_t value) {
+    if (std::isnan(value)) return 0;
+    if (value <= std::numeric_limits<int>::min()) return std::numeric_limits<int>::min();
+    if (value >= std::numeric_limits<int>::max()) return std::numeric_limits<int>::max();
+    return static_cast<int>(value);
+}
+
+// The array element currently being read. Keys can come in any order, so an element is only
+// stored once its closing brace arrives. The strings keep their capacity from one element to the next.
+struct Entry {
+    std::string itemType;
+    std::string fingerprint;
+    std::string oid;
+    std::string tag;
+    int count = 0;
+    int xp = 0;
+    int completes = 0;
+    int tier = 0;
+
+    void reset() {
+        itemType.clear();
+        fingerprint.clear();
+        oid.clear();
+        tag.clear();
+        count = xp = completes = tier = 0;
+    }
+};
+
+// Depth counts the open containers: 1 is the root object, 2 a section array (or the PlayerSkills
+// object), 3 one element of it and 4 the {"$oid": ...} object of an upgrade's ItemId.
+class PlayerSax {
+public:
+    PlayerSax(InventorySnapshot& out, PlayerExtras& extras) : out(out), extras(extras) {}
+
+    bool null() { field = Field::Other; return true; }
+    bool boolean(bool) { field = Field::Other; return true; }
+    bool number_integer(json::number_integer_t value) { return number(ClampToInt(value)); }
+    bool number_unsigned(json::number_unsigned_t value) { return number(ClampToInt(value)); }
+    bool number_float(json::number_float_t value, const json::string_t&) { return number(ClampToInt(value)); }
+    bool binary(json::binary_t&) { field = Field::Other; return true; }
+
+    bool string(json::string_t& value) {
+        if (depth == 3 && isList()) {
+            switch (field) {
+                case Field::ItemType:           entry.itemType = value; break;
+                case Field::UpgradeFingerprint: entry.fingerprint = value; break;
+                case Field::ItemId:             entry.oid = value; break;
+                case Field::Tag:                entry.tag = value; break;
+                default: break;
+            }
+        } else if (depth == 4 && inItemId && field == Field::Oid) {
+            entry.oid = value;
+        }
+        field = Field::Other;
+        return true;
+    }
+
+    bool key(json::string_t& key) {
+        if (depth == 1) {
+            section = SectionFromKey(key);
+        } else if (depth == 2 && section == Section::PlayerSkills) {
+            skillKey = key;
+        } else if (depth == 3 && isList()) {
+            field = FieldFromKey(key);
+        } else if (depth == 4 && inItemId) {
+            field = key == "$oid" ? Field::Oid : Field::Other;
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        if (depth == 2 && isList()) {
+            entry.reset();
+        } else if (depth == 3 && field == Field::ItemId) {
+            inItemId = true;
+        }
+        ++depth;
+        field = Field::Other;
+        return true;
+    }
+
+    bool end_object() {
+        --depth;
+        if (depth == 2 && isList()) {
+            commit();
+        } else if (depth == 3) {
+            inItemId = false;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        ++depth;
+        field = Field::Other;
+        return true;
+    }
+
+    bool end_array() {
+        --depth;
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const json::exception& e) {
+        LogThis(LogLevel::Error, "player data is not valid json at byte ", position, ": ", e.what());
+        return false;
+    }
+
+private:
+    bool number(int value) {
+        if (depth == 1 && section == Section::PlayerLevel) {
+            out.masteryRank = value;
+        } else if (depth == 2 && section == Section::PlayerSkills) {
+            extras.skills.emplace_back(skillKey, value);
+        } else if (depth == 3 && isList()) {
+            switch (field) {
+                case Field::ItemCount: entry.count = value; break;
+                case Field::XP:        entry.xp = value; break;
+                case Field::Completes: entry.completes = value; break;
+                case Field::Tier:      entry.tier = value; break;
+                default: break;
+            }
+        }
+        field = Field::Other;
+        return true;
+    }
+
+    [[nodiscard]] bool isList() const {
+        return section != Section::Other && section != Section::PlayerLevel && section != Section::PlayerSkills;
+    }
+
+    void commit() {
+        switch (section) {
+            case Section::Recipes:
+            case Section::MiscItems:
+                if (!entry.itemType.empty()) {
+                    out.counts[InternId(entry.itemType)] = entry.count;
+                }
+                break;
+            case Section::RawUpgrades:
+                if (!entry.itemType.empty() && entry.count > 0) {
+                    out.upgrades[InternId(entry.itemType)][0] += entry.count;
+                }
+                break;
+            case Section::Upgrades:
+                commitUpgrade();
+                break;
+            case Section::XPInfo:
+                if (!entry.itemType.empty()) {
+                    out.xp[InternId(entry.itemType)] = entry.xp;
+                }
+                break;
+            case Section::Missions:
+                if (!entry.tag.empty()) {
+                    extras.missions.push_back({entry.tag, entry.completes, entry.tier});
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void commitUpgrade() {
+        if (entry.itemType.empty() || entry.fingerprint.empty()) return;
+
+        try {
+            if (entry.fingerprint.find("\"compat\"") != std::string::npos) {
+                if (!entry.oid.empty()) {
+                    out.rivenFingerprints.insert({entry.oid, entry.fingerprint});
+                } else {
+                    LogThis("Could not get rivenId for riven: " + entry.itemType);
+                }
+                return;
+            }
+
+            int lvl = FingerprintLevel(entry.fingerprint);
+            if (lvl >= 0) {
+                out.upgrades[InternId(entry.itemType)][lvl] += 1;
+            } else {
+                LogThis("error getting level from fingerprint id: " + entry.itemType);
+            }
+        } catch (...) {
+            LogThis("fatal error getting level from id: " + entry.itemType);
+        }
+    }
+
+    InventorySnapshot& out;
+    PlayerExtras& extras;
+
+    int depth = 0;
+    Section section = Section::Other;
+    Field field = Field::Other;
+    bool inItemId = false;
+    std::string skillKey;
+    Entry entry;
+};
+
+} // namespace
+
+int FingerprintLevel(std::string_view fingerprint) {
+    if (const auto level = ScanFingerprintLevel(fingerprint)) {
+        return *level;
+    }
+    return json::parse(fingerprint).value("lvl", -1);
+}
+
+bool ReadPlayerData(std::istream& input, InventorySnapshot& out, PlayerExtras& extras) {
+    PlayerSax handler(out, extras);
+    if (json::sax_parse(input, &handler)) return true;
+
+    //never hand out half an inventory
+    out.counts.clear();
+    out.upgrades.clear();
+    out.rivenFingerprints.clear();
+    out.xp.clear();
+    out.masteryRank = 0;
+    extras = {};
+    return false;
+}
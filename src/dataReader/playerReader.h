@@ -0,0 +1,35 @@
+#ifndef PLAYERREADER_H
+#define PLAYERREADER_H
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct InventorySnapshot;
+
+// Completion state of one entry of the "Missions" array
+struct MissionProgress {
+    std::string tag;
+    int completes = 0;
+    int tier = 0;
+};
+
+// The parts of player_data.json that are not stored in the InventorySnapshot itself
+struct PlayerExtras {
+    std::vector<MissionProgress> missions;
+    std::vector<std::pair<std::string, int>> skills; //PlayerSkills in file order, the order carries the categories
+};
+
+// Reads "lvl" from an UpgradeFingerprint like {"lvl":5,"hof":0}. A plain integer lvl is picked out with
+// a single allocation free scan; anything else (no lvl, a float, broken input) goes through a full
+// json parse, so the result and the exceptions thrown are the same as json::parse(...).value("lvl", -1).
+int FingerprintLevel(std::string_view fingerprint);
+
+// Streams player_data.json through a SAX handler and fills counts, upgrades, rivenFingerprints, xp and
+// masteryRank of 'out' straight from the parse events, without ever building a json DOM.
+// On a parse error everything read so far is dropped again and false is returned.
+bool ReadPlayerData(std::istream& input, InventorySnapshot& out, PlayerExtras& extras);
+
+#endif //PLAYERREADER_H
@@ -0,0 +1,311 @@
+#include "searchIndex.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <iterator>
+
+namespace {
+
+//how well a query word matched, the higher the better
+enum MatchQuality : uint32_t {
+    NoMatch   = 0,
+    TwoTypos  = 3,
+    Substring = 4,
+    OneTypo   = 5,
+    Prefix    = 7,
+    Exact     = 10
+};
+
+//bonus for the whole query inside the item's name
+const uint32_t nameContainsBonus = 10;
+const uint32_t nameStartsBonus = 20;
+const uint32_t nameEqualsBonus = 40;
+
+const size_t maxTypoLength = 32; //longer words only match without typos
+const size_t maxGramLength = 3;
+
+uint32_t FieldWeight(SearchField field) {
+    switch (field) {
+        case SearchField::Name: return 4;
+        case SearchField::Part: return 2;
+        case SearchField::Category: return 1;
+    }
+    return 1;
+}
+
+char FoldCase(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+//letters, digits and everything outside ASCII make up words, the rest separates them
+bool IsWordByte(char c) {
+    const auto byte = static_cast<unsigned char>(c);
+    return (byte >= 'a' && byte <= 'z') || (byte >= '0' && byte <= '9') || byte >= 0x80;
+}
+
+//folded words of text, in order
+std::vector<std::string> SplitWords(std::string_view text) {
+    std::vector<std::string> result;
+    std::string current;
+    for (char c : text) {
+        c = FoldCase(c);
+        if (IsWordByte(c)) {
+            current.push_back(c);
+        } else if (!current.empty()) {
+            result.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) result.push_back(std::move(current));
+    return result;
+}
+
+//the gram length goes into the top byte so grams of different lengths never collide
+uint32_t GramKey(std::string_view text, size_t pos, size_t length) {
+    uint32_t key = static_cast<uint32_t>(length) << 24;
+    for (size_t i = 0; i < length; ++i) {
+        key |= static_cast<uint32_t>(static_cast<unsigned char>(text[pos + i])) << (8 * (length - 1 - i));
+    }
+    return key;
+}
+
+uint32_t LetterMask(std::string_view word) {
+    uint32_t mask = 0;
+    for (char c : word) {
+        if (c >= 'a' && c <= 'z') mask |= 1u << (c - 'a');
+        else if (c >= '0' && c <= '9') mask |= 1u << 26;
+        else mask |= 1u << 27;
+    }
+    return mask;
+}
+
+size_t AllowedTypos(size_t length) {
+    if (length < 4) return 0;
+    if (length < 8) return 1;
+    return 2;
+}
+
+//edit distance counting swapped neighbours as one edit, anything above 'limit' comes back as limit + 1
+size_t BoundedDistance(std::string_view a, std::string_view b, size_t limit) {
+    if (a.size() > maxTypoLength || b.size() > maxTypoLength) return limit + 1;
+
+    std::array<size_t, maxTypoLength + 1> beforePrevious{}, previous{}, current{};
+    for (size_t j = 0; j <= b.size(); ++j) previous[j] = j;
+
+    for (size_t i = 1; i <= a.size(); ++i) {
+        current[0] = i;
+        size_t rowMin = current[0];
+        for (size_t j = 1; j <= b.size(); ++j) {
+            const size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost});
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                current[j] = std::min(current[j], beforePrevious[j - 2] + 1);
+            }
+            rowMin = std::min(rowMin, current[j]);
+        }
+        if (rowMin > limit) return limit + 1;
+        beforePrevious = previous;
+        previous = current;
+    }
+    return std::min(previous[b.size()], limit + 1);
+}
+
+MatchQuality ContainQuality(std::string_view word, std::string_view queryWord) {
+    const size_t pos = word.find(queryWord);
+    if (pos == std::string_view::npos) return NoMatch;
+    if (pos != 0) return Substring;
+    return word.size() == queryWord.size() ? Exact : Prefix;
+}
+
+//only for words that do not contain queryWord, those are rated by ContainQuality
+MatchQuality TypoQuality(std::string_view word, uint32_t wordLetters, std::string_view queryWord, uint32_t queryLetters,
+                         size_t typos) {
+    //every edit changes at most two letters of the mask
+    if (std::popcount(wordLetters ^ queryLetters) > static_cast<int>(2 * typos)) {
+        return NoMatch;
+    }
+    switch (BoundedDistance(word, queryWord, typos)) {
+        case 1: return OneTypo;
+        case 2: return TwoTypos;
+        default: return NoMatch;
+    }
+}
+
+} // namespace
+
+void SearchIndex::clear() {
+    words.clear();
+    wordIds.clear();
+    gramWords.clear();
+    wordsByLength.clear();
+    names.clear();
+}
+
+uint32_t SearchIndex::addItem() {
+    names.emplace_back();
+    return static_cast<uint32_t>(names.size() - 1);
+}
+
+void SearchIndex::addText(std::string_view text, SearchField field) {
+    const uint32_t item = static_cast<uint32_t>(names.size() - 1);
+    if (field == SearchField::Name && names.back().empty()) {
+        std::string& name = names.back();
+        name.reserve(text.size());
+        for (char c : text) name.push_back(FoldCase(c));
+    }
+
+    for (std::string& wordText : SplitWords(text)) {
+        auto [it, inserted] = wordIds.try_emplace(wordText, static_cast<uint32_t>(words.size()));
+        if (inserted) {
+            Word& word = words.emplace_back();
+            word.letters = LetterMask(wordText);
+            word.text = std::move(wordText);
+            addWord(it->second);
+        }
+
+        std::vector<Posting>& postings = words[it->second].postings;
+        if (postings.empty() || postings.back().item != item) {
+            postings.push_back({item, field});
+        } else if (field < postings.back().field) {
+            postings.back().field = field;
+        }
+    }
+}
+
+//a new word goes into the gram lists and its length bucket
+void SearchIndex::addWord(uint32_t word) {
+    const std::string_view text = words[word].text;
+    for (size_t length = 1; length <= maxGramLength; ++length) {
+        for (size_t pos = 0; pos + length <= text.size(); ++pos) {
+            std::vector<uint32_t>& list = gramWords[GramKey(text, pos, length)];
+            if (list.empty() || list.back() != word) list.push_back(word);
+        }
+    }
+    if (text.size() <= maxTypoLength) {
+        if (wordsByLength.size() <= text.size()) wordsByLength.resize(text.size() + 1);
+        wordsByLength[text.size()].push_back(word);
+    }
+}
+
+//every word queryWord matches and how well; a word may show up twice, the better rating counts
+void SearchIndex::matchWords(std::string_view queryWord, std::vector<WordMatch>& matches) const {
+    matches.clear();
+
+    //words containing queryWord: up to a trigram the gram list is the answer, longer queries take the words
+    //holding all of their trigrams and confirm those with a find
+    if (queryWord.size() <= maxGramLength) {
+        if (auto it = gramWords.find(GramKey(queryWord, 0, queryWord.size())); it != gramWords.end()) {
+            for (uint32_t word : it->second) {
+                matches.push_back({word, ContainQuality(words[word].text, queryWord)});
+            }
+        }
+    } else {
+        //shortest list first, every further list can only shrink the candidates
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (size_t pos = 0; pos + maxGramLength <= queryWord.size(); ++pos) {
+            auto it = gramWords.find(GramKey(queryWord, pos, maxGramLength));
+            if (it == gramWords.end()) {
+                lists.clear();
+                break;
+            }
+            lists.push_back(&it->second);
+        }
+        if (!lists.empty()) {
+            std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+                return a->size() != b->size() ? a->size() < b->size() : std::less<>()(a, b);
+            });
+            lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+            std::vector<uint32_t> candidates = *lists.front();
+            std::vector<uint32_t> narrowed;
+            for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+                narrowed.clear();
+                std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+                                      std::back_inserter(narrowed));
+                candidates.swap(narrowed);
+            }
+            for (uint32_t word : candidates) {
+                if (const MatchQuality quality = ContainQuality(words[word].text, queryWord); quality != NoMatch) {
+                    matches.push_back({word, quality});
+                }
+            }
+        }
+    }
+
+    //typos: a word within reach differs in length by no more than the typos allowed
+    const size_t typos = AllowedTypos(queryWord.size());
+    if (typos == 0) return;
+    const uint32_t queryLetters = LetterMask(queryWord);
+    const size_t shortest = queryWord.size() - typos;
+    const size_t longest = std::min(queryWord.size() + typos, wordsByLength.empty() ? 0 : wordsByLength.size() - 1);
+    for (size_t length = shortest; length <= longest; ++length) {
+        for (uint32_t word : wordsByLength[length]) {
+            const Word& candidate = words[word];
+            if (candidate.text.find(queryWord) != std::string::npos) continue; //already rated above
+            if (const MatchQuality quality = TypoQuality(candidate.text, candidate.letters, queryWord, queryLetters, typos);
+                quality != NoMatch) {
+                matches.push_back({word, quality});
+            }
+        }
+    }
+}
+
+std::vector<uint32_t> SearchIndex::match(std::string_view query) const {
+    const std::vector<std::string> queryWords = SplitWords(query);
+    std::vector<uint32_t> result;
+    if (queryWords.empty()) {
+        result.resize(size());
+        for (uint32_t item = 0; item < size(); ++item) result[item] = item;
+        return result;
+    }
+
+    std::vector<uint32_t> score(size(), 0);
+    std::vector<uint32_t> matchedWords(size(), 0); //an item stays a candidate while this equals the query words done so far
+    std::vector<uint32_t> wordBest(size(), 0);
+    std::vector<uint32_t> touched;
+    std::vector<WordMatch> wordMatches;
+    for (uint32_t done = 0; done < queryWords.size(); ++done) {
+        matchWords(queryWords[done], wordMatches);
+
+        touched.clear();
+        for (const WordMatch& wordMatch : wordMatches) {
+            for (const Posting& posting : words[wordMatch.word].postings) {
+                if (matchedWords[posting.item] != done) continue;
+                const uint32_t value = wordMatch.quality * FieldWeight(posting.field);
+                if (wordBest[posting.item] == 0) touched.push_back(posting.item);
+                wordBest[posting.item] = std::max(wordBest[posting.item], value);
+            }
+        }
+        if (touched.empty()) return result;
+
+        for (uint32_t item : touched) {
+            score[item] += wordBest[item];
+            wordBest[item] = 0;
+            ++matchedWords[item];
+        }
+    }
+
+    std::string phrase;
+    for (const std::string& queryWord : queryWords) {
+        if (!phrase.empty()) phrase.push_back(' ');
+        phrase += queryWord;
+    }
+
+    for (uint32_t item : touched) { //the last query word only touched items that matched all the others
+        const std::string& name = names[item];
+        if (name == phrase) score[item] += nameEqualsBonus;
+        else if (name.starts_with(phrase)) score[item] += nameStartsBonus;
+        else if (name.find(phrase) != std::string::npos) score[item] += nameContainsBonus;
+        result.push_back(item);
+    }
+
+    //best score first, then the shorter name since more of it was asked for, then the original order
+    std::sort(result.begin(), result.end(), [&](uint32_t a, uint32_t b) {
+        if (score[a] != score[b]) return score[a] > score[b];
+        if (names[a].size() != names[b].size()) return names[a].size() < names[b].size();
+        return a < b;
+    });
+    return result;
+}
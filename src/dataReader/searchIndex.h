@@ -0,0 +1,62 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// which part of an item a text belongs to, earlier ones weigh more in the ranking
+enum class SearchField : uint8_t {
+    Name,     //the item itself
+    Part,     //ingredients, relic rewards
+    Category
+};
+
+// Ranked word search over a fixed list of items, built once per page.
+// Texts are folded to lowercase and split into words while building; every distinct word keeps the items it
+// appears in. A query is split the same way and each of its words has to match a word of the item: exactly,
+// as a prefix, anywhere inside it or, for words of 4+ characters, with a typo or two.
+// Words are found through their 1-, 2- and 3-grams, so a query word only looks at the words containing it;
+// typo candidates come from the words of about the same length.
+// Items are ranked by how well and where their words matched, with a bonus when the whole query shows up
+// in the name. Folding only covers ASCII, other UTF-8 bytes have to match exactly.
+class SearchIndex {
+public:
+    void clear();
+    uint32_t addItem(); //starts the next item and returns its index, items are numbered from 0
+    void addText(std::string_view text, SearchField field); //to the item added last, its first Name is what the query bonus looks at
+
+    //indices of the matching items, best first; an empty query matches everything in index order
+    [[nodiscard]] std::vector<uint32_t> match(std::string_view query) const;
+    [[nodiscard]] size_t size() const { return names.size(); }
+
+private:
+    struct Posting {
+        uint32_t item;
+        SearchField field; //the best one the word appears in for this item
+    };
+
+    struct Word {
+        std::string text;
+        uint32_t letters = 0; //one bit per letter/digit it contains, rules out most typo candidates cheaply
+        std::vector<Posting> postings; //ascending by item
+    };
+
+    struct WordMatch {
+        uint32_t word;
+        uint32_t quality;
+    };
+
+    void addWord(uint32_t word);
+    void matchWords(std::string_view queryWord, std::vector<WordMatch>& matches) const;
+
+    std::vector<Word> words;
+    std::unordered_map<std::string, uint32_t> wordIds; //text -> index in words
+    std::unordered_map<uint32_t, std::vector<uint32_t>> gramWords; //1-, 2- and 3-gram -> words containing it, ascending
+    std::vector<std::vector<uint32_t>> wordsByLength; //typo candidates by length, too long ones never match with a typo and are left out
+    std::vector<std::string> names; //lowercase name of every item
+};
+
+#endif //SEARCHINDEX_H
@@ -0,0 +1,157 @@
+#include "ImageScheduler.h"
+#include <algorithm>
+#include <QMetaObject>
+
+#include "ThumbnailCache.h"
+
+namespace {
+
+const int loadThreads = 4; //downloads share one connection pool, more threads mostly wait on each other
+const int maxFailures = 2; //an image that does not decode twice will not decode the third time either
+
+std::string KeyOf(const std::string& image, int height) {
+    return image + "@" + std::to_string(height);
+}
+
+} // namespace
+
+ImageScheduler& ImageScheduler::instance() {
+    static ImageScheduler scheduler;
+    return scheduler;
+}
+
+ImageScheduler::ImageScheduler() {
+    pool.setMaxThreadCount(loadThreads);
+}
+
+ImageScheduler::~ImageScheduler() {
+    {
+        std::lock_guard lock(mutex);
+        queue.clear();
+    }
+    pool.clear();
+    pool.waitForDone();
+}
+
+void ImageScheduler::request(const std::string& image, int height, bool saveDownload, ImagePriority priority,
+                             QObject* receiver, Stale stale, Ready ready) {
+    std::lock_guard lock(mutex);
+    Job& job = enqueueLocked(image, height, saveDownload, priority);
+    job.waiters.push_back({receiver, std::move(stale), std::move(ready), priority});
+}
+
+void ImageScheduler::prefetch(const std::string& image, int height, bool saveDownload, ImagePriority priority) {
+    if (!CachedThumbnail(image, height).isNull()) return;
+
+    std::lock_guard lock(mutex);
+    Job& job = enqueueLocked(image, height, saveDownload, priority);
+    job.pass = currentPass;
+}
+
+void ImageScheduler::beginPass() {
+    std::lock_guard lock(mutex);
+    ++currentPass;
+}
+
+//caller holds the lock
+ImageScheduler::Job& ImageScheduler::enqueueLocked(const std::string& image, int height, bool saveDownload,
+                                                   ImagePriority priority) {
+    const std::string key = KeyOf(image, height);
+    auto [it, inserted] = jobs.try_emplace(key);
+    Job& job = it->second;
+
+    if (inserted) {
+        job.image = image;
+        job.height = height;
+        job.saveDownload = saveDownload;
+        job.priority = priority;
+        job.order = nextOrder++;
+        queue.emplace(QueueKey{priority, job.order}, key);
+        pool.start([this]() { runNext(); });
+    } else if (!job.running && priority < job.priority) {
+        auto node = queue.extract(QueueKey{job.priority, job.order});
+        node.key() = QueueKey{priority, job.order};
+        queue.insert(std::move(node));
+        job.priority = priority;
+    }
+    job.saveDownload = job.saveDownload || saveDownload;
+    return job;
+}
+
+//caller holds the lock; puts a job that already ran back into the queue for the waiters it still has
+void ImageScheduler::requeueLocked(const std::string& key, Job& job) {
+    job.running = false;
+    job.priority = std::min_element(job.waiters.begin(), job.waiters.end(), [](const Waiter& a, const Waiter& b) {
+        return a.priority < b.priority;
+    })->priority;
+    job.order = nextOrder++;
+    queue.emplace(QueueKey{job.priority, job.order}, key);
+    pool.start([this]() { runNext(); });
+}
+
+//caller holds the lock
+bool ImageScheduler::wantedLocked(Job& job) {
+    std::erase_if(job.waiters, [](const Waiter& waiter) {
+        return !waiter.receiver || (waiter.stale && waiter.stale());
+    });
+    return !job.waiters.empty() || job.pass == currentPass;
+}
+
+//every queued job starts one of these, so the pool decides how many run and the queue decides which
+void ImageScheduler::runNext() {
+    std::string key;
+    std::string image;
+    int height = 0;
+    bool saveDownload = false;
+    {
+        std::lock_guard lock(mutex);
+        while (true) {
+            if (queue.empty()) return;
+            key = std::move(queue.begin()->second);
+            queue.erase(queue.begin());
+
+            Job& job = jobs.at(key);
+            if (!wantedLocked(job)) {
+                jobs.erase(key);
+                continue;
+            }
+            job.running = true;
+            image = job.image;
+            height = job.height;
+            saveDownload = job.saveDownload;
+            break;
+        }
+    }
+
+    bool cancelled = false;
+    QImage loaded = LoadThumbnail(image, height, saveDownload, [this, &key, &cancelled]() {
+        std::lock_guard lock(mutex);
+        cancelled = !wantedLocked(jobs.at(key));
+        return cancelled;
+    });
+
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard lock(mutex);
+        Job& job = jobs.at(key);
+        if (loaded.isNull() && wantedLocked(job) && !job.waiters.empty()) {
+            //a request can join after the load was cancelled for having nobody waiting, those must not stay blank
+            if (cancelled || ++job.failures < maxFailures) {
+                requeueLocked(key, job);
+                return;
+            }
+        }
+        waiters = std::move(job.waiters);
+        jobs.erase(key);
+    }
+    if (loaded.isNull()) return;
+
+    for (Waiter& waiter : waiters) {
+        QObject* receiver = waiter.receiver.data();
+        if (!receiver) continue;
+        QMetaObject::invokeMethod(receiver, [waiter = std::move(waiter), loaded]() {
+            if (!waiter.receiver || (waiter.stale && waiter.stale())) return;
+            waiter.ready(loaded);
+        }, Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QImage>
+#include <QPointer>
+#include <QThreadPool>
+
+// lower goes first
+enum class ImagePriority {
+    Visible,
+    Buffer, //the rows kept around the viewport
+    Ahead   //rows the scroll is heading to
+};
+
+// Loads thumbnails on a small pool of its own, highest priority first. Requests for the same image and
+// height share one load; asking again with a higher priority moves the queued load forward.
+// Prefetches only count for the current pass: whatever a new pass does not ask for again is dropped
+// before it reaches the network, as are loads whose every requester went stale.
+class ImageScheduler {
+public:
+    using Ready = std::function<void(const QImage&)>; //called on the receiver's thread
+    using Stale = std::function<bool()>; //may be called from any thread
+
+    static ImageScheduler& instance();
+
+    void request(const std::string& image, int height, bool saveDownload, ImagePriority priority,
+                 QObject* receiver, Stale stale, Ready ready);
+    void prefetch(const std::string& image, int height, bool saveDownload, ImagePriority priority);
+    void beginPass(); //call before the prefetches for a new scroll position
+
+private:
+    ImageScheduler();
+    ~ImageScheduler();
+
+    struct Waiter {
+        QPointer<QObject> receiver;
+        Stale stale;
+        Ready ready;
+        ImagePriority priority = ImagePriority::Visible;
+    };
+
+    struct Job {
+        std::string image;
+        int height = 0;
+        bool saveDownload = false;
+        ImagePriority priority = ImagePriority::Ahead;
+        uint64_t order = 0;
+        uint64_t pass = 0;
+        bool running = false;
+        int failures = 0; //loads that came back empty although nobody cancelled them
+        std::vector<Waiter> waiters;
+    };
+
+    using QueueKey = std::pair<ImagePriority, uint64_t>; //priority, then first come first served
+
+    Job& enqueueLocked(const std::string& image, int height, bool saveDownload, ImagePriority priority);
+    void requeueLocked(const std::string& key, Job& job);
+    bool wantedLocked(Job& job); //drops stale waiters on the way
+    void runNext();
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Job> jobs; //queued and running, by image@height
+    std::map<QueueKey, std::string> queue;
+    uint64_t nextOrder = 0;
+    uint64_t currentPass = 0;
+    QThreadPool pool;
+};
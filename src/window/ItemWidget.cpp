@@ -4,12 +4,13 @@
 #include <QGridLayout>
 #include <QLabel>
 #include <QPainter>
-#include <QtConcurrent>
 #include <QVBoxLayout>
 #include <QImageReader>
 
 #include "mainwindow.h"
+#include "ImageScheduler.h"
 #include "PartWidget.h"
+#include "ThumbnailCache.h"
 #include "apiParser/apiParser.h"
 #include "dataReader/dataReader.h"
 #include "FileAccess/FileAccess.h"
@@ -90,10 +91,7 @@ ItemWidget::ItemWidget(IDataContainer* dataContainer,
         rightHalf->hide();
     }
     // Load the arbitration unlock image
-    auto unlockImgBytesPtr = fetchUrlCached(imgFromId("/Lotus/Types/Items/UnlockArbitrationKeyItem"), FetchType::PNG);
-    QByteArray unlockImgBytes(reinterpret_cast<const char*>(unlockImgBytesPtr->data()), unlockImgBytesPtr->size());
-    QPixmap unlockImg;
-    unlockImg.loadFromData(unlockImgBytes);
+    QPixmap unlockImg = QPixmap::fromImage(LoadThumbnail(imgFromId("/Lotus/Types/Items/UnlockArbitrationKeyItem"), 0, false));
 
     unlockIconLabel = new QLabel(leftHalf);
     unlockIconLabel->setScaledContents(true);
@@ -242,7 +240,7 @@ void ItemWidget::resetData(IDataContainer* newData) {
 
     mainItemLabel->setText(QString::fromStdString(newData->getMainData().getName()));
 
-    const auto& subData = dataContainer->getSubData();
+    const auto subData = dataContainer->getSubData();
 
     int neededSize = static_cast<int>(subData.size());
     int currentSize = m_circles.size();
@@ -262,7 +260,7 @@ void ItemWidget::resetData(IDataContainer* newData) {
     }
 
     for (int i = 0; i < neededSize; ++i) {
-        const auto& itemData = *subData[i];
+        const auto& itemData = subData[i];
         m_circles[i]->setPixmap(QPixmap());
         m_circles[i]->setItemData(itemData);
         m_circles[i]->show();
@@ -502,66 +500,53 @@ void ItemWidget::mousePressEvent(QMouseEvent *event) {
     QWidget::mousePressEvent(event);
 }
 
-//TODO: move both into a real background thread class/make another one that handles just this
-void ItemWidget::loadImagesAsync() {
-    if (!dataContainer) return;
+namespace {
 
-    // Main image loading
-    std::string imageUrl = dataContainer->getMainData().getImage();
-    QPointer mainWidget = m_mainImgWidget;
-    //Clion complains this is unused if [[maybe_unused]] is not set
-    [[maybe_unused]] bool saveDownload = MainWindow::getWindowSettings().saveDownload;
+const int mainImageHeight = 180;
+const int partImageHeight = 180; //parts are scaled again to their circle, this just caps what is kept
 
-    (void) QtConcurrent::run([imageUrl, mainWidget, saveDownload]() {
-        std::shared_ptr<const std::vector<uint8_t>> imgBytesPtr;
-        if (saveDownload) {
-            imgBytesPtr = GetImageByFileOrDownload(imageUrl);
-        } else {
-            imgBytesPtr = fetchUrlCached(imageUrl, FetchType::PNG);
-        }
+using LoadGeneration = std::shared_ptr<std::atomic<uint64_t>>;
+
+// Shows a cached thumbnail right away, otherwise asks the scheduler and sets it once ready.
+// A pooled widget may have been handed other data in the meantime, so the load checks the generation:
+// queued loads that went stale never download, finished ones never paint over the newer image.
+template<typename Target>
+void ShowThumbnail(QPointer<Target> target, const std::string& image, int height, bool saveDownload,
+                   const LoadGeneration& generation, uint64_t expected) {
+    if (!target) return;
+    if (QImage cached = CachedThumbnail(image, height); !cached.isNull()) {
+        target->setPixmap(QPixmap::fromImage(cached));
+        return;
+    }
+    target->setPixmap(QPixmap());
+
+    //visible rows were already raised by MainWindow's prefetch pass, requests merge with it
+    ImageScheduler::instance().request(image, height, saveDownload, ImagePriority::Buffer, target.data(),
+        [generation, expected]() {
+            return generation->load(std::memory_order_relaxed) != expected;
+        },
+        [target](const QImage& loaded) {
+            if (target) target->setPixmap(QPixmap::fromImage(loaded));
+        });
+}
 
-        if (!imgBytesPtr || imgBytesPtr->empty()) return;
+} // namespace
 
-        QByteArray imgBytes(reinterpret_cast<const char*>(imgBytesPtr->data()), static_cast<long long>(imgBytesPtr->size()));
-        QPixmap pixmap;
-        if (!pixmap.loadFromData(imgBytes)) return;
+void ItemWidget::loadImagesAsync() {
+    if (!dataContainer) return;
 
-        QMetaObject::invokeMethod(mainWidget, [pixmap, mainWidget]() {
-            if (!mainWidget) return;
-            mainWidget->setPixmap(pixmap.scaledToHeight(180, Qt::SmoothTransformation));
-        }, Qt::QueuedConnection);
-    });
+    const bool saveDownload = MainWindow::getWindowSettings().saveDownload;
+    const uint64_t generation = ++*m_imageGeneration;
+    ShowThumbnail(QPointer(m_mainImgWidget), dataContainer->getMainData().getImage(), mainImageHeight, saveDownload,
+                  m_imageGeneration, generation);
 
     // Sub-images loading
-    const auto& subData = dataContainer->getSubData();
+    const auto subData = dataContainer->getSubData();
     auto count = std::min(subData.size(), static_cast<size_t>(m_circles.size()));
 
     for (int i = 0; i < count; ++i) {
-        auto part = subData[i];
-        QPointer partWidget = m_circles[i];
-        if (!partWidget) continue;
-
-        std::string partImgUrl = part->getImage();
-
-        (void) QtConcurrent::run([partImgUrl, partWidget, saveDownload]() {
-            std::shared_ptr<const std::vector<uint8_t>> imgBytesPtr;
-            if (saveDownload) {
-                imgBytesPtr = GetImageByFileOrDownload(partImgUrl);
-            } else {
-                imgBytesPtr = fetchUrlCached(partImgUrl, FetchType::PNG);
-            }
-
-            if (!imgBytesPtr || imgBytesPtr->empty()) return;
-
-            QByteArray imgBytes(reinterpret_cast<const char*>(imgBytesPtr->data()), static_cast<long long>(imgBytesPtr->size()));
-            QPixmap pixmap;
-            if (!pixmap.loadFromData(imgBytes)) return;
-
-            QMetaObject::invokeMethod(partWidget, [pixmap, partWidget]() {
-                if (!partWidget) return;
-                partWidget->setPixmap(pixmap);
-            }, Qt::QueuedConnection);
-        });
+        ShowThumbnail(QPointer(m_circles[i]), subData[i].getImage(), partImageHeight, saveDownload,
+                      m_imageGeneration, generation);
     }
 }
 
@@ -569,34 +554,30 @@ void ItemWidget::loadImagesAsync() {
 void ItemWidget::loadImagesAsyncMod() {
     if (!modData) return;
 
-    std::string imageUrl = modData->getImage();
-    QPointer mainWidget = m_mainImgWidget;
-
-    (void) QtConcurrent::run([imageUrl, mainWidget]() {
-        std::shared_ptr<const std::vector<uint8_t>> imgBytesPtr;
-        if (MainWindow::getWindowSettings().saveDownload) {
-            imgBytesPtr = GetImageByFileOrDownload(imageUrl);
-        }
-        else {
-            imgBytesPtr = fetchUrlCached(imageUrl, FetchType::PNG);
-        }
+    const bool saveDownload = MainWindow::getWindowSettings().saveDownload;
+    const uint64_t generation = ++*m_imageGeneration;
+    ShowThumbnail(QPointer(m_mainImgWidget), modData->getImage(), mainImageHeight, saveDownload,
+                  m_imageGeneration, generation);
+}
 
-        if (!imgBytesPtr || imgBytesPtr->empty()) return;
+void ItemWidget::prefetchImages(const IDataContainer& data, ImagePriority priority, bool saveDownload) {
+    ImageScheduler& scheduler = ImageScheduler::instance();
+    scheduler.prefetch(data.getMainData().getImage(), mainImageHeight, saveDownload, priority);
+    for (const IData& part : data.getSubData()) {
+        scheduler.prefetch(part.getImage(), partImageHeight, saveDownload, priority);
+    }
+}
 
-        QByteArray imgBytes(reinterpret_cast<const char*>(imgBytesPtr->data()), static_cast<long long>(imgBytesPtr->size()));
-        QPixmap pixmap;
-        if (!pixmap.loadFromData(imgBytes)) {
-            return;
-        }
+void ItemWidget::prefetchImages(const IModData& data, ImagePriority priority, bool saveDownload) {
+    ImageScheduler::instance().prefetch(data.getImage(), mainImageHeight, saveDownload, priority);
+}
 
-        QMetaObject::invokeMethod(mainWidget, [pixmap, mainWidget]() {
-            if (!mainWidget) return;
-            mainWidget->setPixmap(pixmap.scaledToHeight(180, Qt::SmoothTransformation));
-        }, Qt::QueuedConnection);
-    });
+void ItemWidget::cancelImageLoads() {
+    ++*m_imageGeneration;
 }
 
 ItemWidget::~ItemWidget() {
+    cancelImageLoads();
     for (QWidget* w : m_possessionItems)
         delete w;
     m_texts.clear();
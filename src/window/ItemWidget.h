@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <qfuture.h>
 #include <QGridLayout>
 #include <QVector>
@@ -7,6 +9,7 @@
 #include <QLabel>
 #include <QPushButton>
 
+#include "ImageScheduler.h"
 #include "dataReader/dataReader.h"
 
 class CircleWidget;
@@ -37,6 +40,10 @@ public:
     [[nodiscard]] const IDataContainer& getDataContainer() const;
     [[nodiscard]] const IModData& getModData() const;
     void updateMainCount();
+    //queues the images resetData would load, for rows that are about to be shown
+    static void prefetchImages(const IDataContainer& data, ImagePriority priority, bool saveDownload);
+    static void prefetchImages(const IModData& data, ImagePriority priority, bool saveDownload);
+    void cancelImageLoads(); //loads still pending for the current data are dropped, queued ones never download
 
 private:
     QHBoxLayout *mainLayout;
@@ -66,6 +73,9 @@ private:
 
     QStringList m_texts;
 
+    //bumped whenever the shown data changes; loads started under an older value are stale
+    std::shared_ptr<std::atomic<uint64_t>> m_imageGeneration = std::make_shared<std::atomic<uint64_t>>(0);
+
 
     void toggleRight();
 
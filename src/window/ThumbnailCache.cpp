@@ -0,0 +1,77 @@
+#include "ThumbnailCache.h"
+#include <QBuffer>
+#include <QCache>
+#include <QImageWriter>
+#include <QMutex>
+#include <QString>
+
+#include "apiParser/apiParser.h"
+#include "FileAccess/FileAccess.h"
+
+namespace {
+
+QMutex thumbnailMutex;
+QCache<QString, QImage> thumbnails(THUMBNAIL_BUDGET / 1024); //cost is in KiB
+
+QString KeyOf(const std::string& image, int height) {
+    return QString::fromStdString(image) + '@' + QString::number(height);
+}
+
+} // namespace
+
+QImage CachedThumbnail(const std::string& image, int height) {
+    QMutexLocker lock(&thumbnailMutex);
+    const QImage* cached = thumbnails.object(KeyOf(image, height));
+    return cached ? *cached : QImage();
+}
+
+QImage LoadThumbnail(const std::string& image, int height, bool saveDownload,
+                     const std::function<bool()>& cancelled) {
+    if (QImage cached = CachedThumbnail(image, height); !cached.isNull()) {
+        return cached;
+    }
+
+    std::shared_ptr<const std::vector<uint8_t>> imgBytesPtr;
+    if (saveDownload) {
+        imgBytesPtr = GetImageByFileOrDownload(image);
+    } else {
+        imgBytesPtr = fetchUrlCached(image, FetchType::PNG);
+    }
+    if (!imgBytesPtr || imgBytesPtr->empty()) return {};
+    if (cancelled && cancelled()) return {};
+
+    QImage decoded;
+    if (!decoded.loadFromData(imgBytesPtr->data(), static_cast<int>(imgBytesPtr->size()))) {
+        LogThis(LogLevel::Debug, "Could not decode image ", image);
+        return {};
+    }
+    if (height > 0) {
+        decoded = decoded.scaledToHeight(height, Qt::SmoothTransformation);
+    }
+
+    //the fallback stands in for a failed download, the next widget should try again
+    if (imgBytesPtr != getFallbackDefaultPng()) {
+        const qsizetype cost = decoded.sizeInBytes() / 1024 + 1;
+        QMutexLocker lock(&thumbnailMutex);
+        thumbnails.insert(KeyOf(image, height), new QImage(decoded), cost);
+    }
+    return decoded;
+}
+
+bool CompactImageEncodingAvailable() {
+    return QImageWriter::supportedImageFormats().contains("webp");
+}
+
+std::vector<uint8_t> CompactImageEncoding(const std::vector<uint8_t>& data) {
+    QImage image;
+    if (!image.loadFromData(data.data(), static_cast<int>(data.size()))) return {};
+
+    QByteArray encoded;
+    QBuffer buffer(&encoded);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, "webp");
+    writer.setQuality(90); //keeps alpha, 100 would switch to lossless
+    if (!writer.write(image)) return {};
+
+    return {encoded.begin(), encoded.end()};
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <QImage>
+
+// Decoded images already scaled to the height they are shown at, shared by every widget and bounded by
+// memory. Thread safe and made of QImages, so the loading happens off the GUI thread; turning them into
+// a QPixmap is left to the caller, which has to do that on the GUI thread.
+const qsizetype THUMBNAIL_BUDGET = 64 * 1024 * 1024;
+
+QImage CachedThumbnail(const std::string& image, int height); //null if not cached; height 0 keeps the original size
+//blocking, downloads and decodes on a miss; cancelled is asked once the bytes are there and skips the decode
+QImage LoadThumbnail(const std::string& image, int height, bool saveDownload,
+                     const std::function<bool()>& cancelled = {});
+
+// Lossy WebP for the disk cache; only there if Qt has the webp image plugin, empty if the image can't be read
+bool CompactImageEncodingAvailable();
+std::vector<uint8_t> CompactImageEncoding(const std::vector<uint8_t>& data);
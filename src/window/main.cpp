@@ -1,6 +1,7 @@
-#include <fstream>
-
 #include "mainwindow.h"
+#include "FileAccess/FileAccess.h"
+#include "FileAccess/imageCache.h"
+#include "ThumbnailCache.h"
 
 #include <iostream>
 #include <QApplication>
@@ -9,9 +10,6 @@
 
 int main(int argc, char *argv[])
 {
-    //Clearing the Log
-    std::ofstream logFile("../data/Log/Log.txt", std::ofstream::trunc);
-
     QApplication a(argc, argv);
 
     /*QTranslator translator;
@@ -29,9 +27,17 @@ int main(int argc, char *argv[])
     darkPalette.setColor(QPalette::Window, QColor(40, 40, 40));
     a.setPalette(darkPalette);
 
+    //lossy, so only when asked for in the options
+    if (LoadSettings().compactImages && CompactImageEncodingAvailable()) {
+        ImageDiskCache().setTranscoder(CompactImageEncoding);
+    }
+
     MainWindow w;
     w.setWindowTitle("SadPrime");
     w.setStyleSheet("background-color: #282828;");
     w.show();
-    return a.exec();
+    const int result = a.exec();
+    FlushImageCache(); //keeps the last use order for the next start
+    ShutdownLog(); //write out whatever is still queued before the statics go away
+    return result;
 }
@@ -8,9 +8,11 @@
 #include <QInputDialog>
 #include <QGroupBox>
 #include <QSpinBox>
+#include <QtConcurrent>
 
 #include "ItemWidget.h"
 #include "mainwindow.h"
+#include "ThumbnailCache.h"
 
 #include <qguiapplication.h>
 #include <qscreen.h>
@@ -20,22 +22,10 @@
 #include "overviewPartWidget.h"
 #include "apiParser/apiParser.h"
 #include "autostart/autostart.h"
+#include "dataReader/catalogSnapshot.h"
 #include "dataReader/dataReader.h"
 #include "FileAccess/FileAccess.h"
 
-//TODO: Move somewhere better
-bool caseInsensitiveFind(const std::string& str, const std::string& search) {
-    if (search.empty()) return true; // empty filter matches anything
-
-    std::string strLower = str;
-    std::string searchLower = search;
-
-    std::transform(strLower.begin(), strLower.end(), strLower.begin(), ::tolower);
-    std::transform(searchLower.begin(), searchLower.end(), searchLower.begin(), ::tolower);
-
-    return strLower.find(searchLower) != std::string::npos;
-}
-
 Settings MainWindow::settings;
 std::mutex MainWindow::settingsMutex;
 
@@ -102,63 +92,6 @@ MainWindow::MainWindow(QWidget *parent)
 
     mainLayout->addWidget(contentArea, /*stretch*/ 3);
 
-    // Define filter functions (Important to call this after createLazyLoadingPage())
-    IDataContainerFilterFunc = [this](const IDataContainer* data) -> bool {
-        InventoryCategories cat = data->getMainData().getCategory();
-
-        if (excludeComboBox->getSelectedCategories() != InventoryCategories::None &&
-            hasCategory(cat, excludeComboBox->getSelectedCategories()))
-            return false;
-
-        if (includeComboBox->getSelectedCategories() != InventoryCategories::None &&
-            !hasCategoryStrict(cat, includeComboBox->getSelectedCategories()))
-            return false;
-
-        QString searchText = searchBar->text().trimmed();
-        if (!searchText.isEmpty()) {
-            // Check main data name
-            QString mainName = QString::fromStdString(data->getMainData().getName());
-            if (mainName.contains(searchText, Qt::CaseInsensitive)) {
-                return true;
-            }
-
-            // Check sub data array
-            const auto& subDataArray = data->getSubData();
-            return std::any_of(
-                subDataArray.begin(),
-                subDataArray.end(),
-                [&](const auto& subData) {
-                    QString subName = QString::fromStdString(subData->getName());
-                    return subName.contains(searchText, Qt::CaseInsensitive);
-                }
-            );
-        }
-
-        return true;
-    };
-
-    IModDataFilterFunc = [this](const IModData* data) -> bool {
-        InventoryCategories cat = data->getCategory();
-
-        if (excludeComboBox->getSelectedCategories() != InventoryCategories::None &&
-            hasCategory(cat, excludeComboBox->getSelectedCategories()))
-            return false;
-
-        if (includeComboBox->getSelectedCategories() != InventoryCategories::None &&
-            !hasCategoryStrict(cat, includeComboBox->getSelectedCategories()))
-            return false;
-
-        QString searchText = searchBar->text().trimmed();
-        if (!searchText.isEmpty()) {
-            QString mainName = QString::fromStdString(data->getName());
-            if (!mainName.contains(searchText, Qt::CaseInsensitive)) {
-                return false;
-            }
-        }
-
-        return true;
-    };
-
     showContentForIndex(0);
 }
 
@@ -267,6 +200,7 @@ void MainWindow::changeToFoundry()
 
     // Clear the other type just to be safe
     storedIModDataVector.clear();
+    rebuildSearchIndex();
 
     // Get dummy size using first element
     if (!storedIDataVector.isEmpty()) {
@@ -290,6 +224,7 @@ void MainWindow::changeToRelics()
 
     // Clear the other type just to be safe
     storedIModDataVector.clear();
+    rebuildSearchIndex();
 
     if (!storedIDataVector.isEmpty()) {
         ItemWidget dummy(storedIDataVector[0], nullptr, {});
@@ -312,6 +247,7 @@ void MainWindow::changeToArcanes()
 
     // Clear the other type just to be safe
     storedIDataVector.clear();
+    rebuildSearchIndex();
 
     if (!storedIModDataVector.isEmpty()) {
         ItemWidget dummy(storedIModDataVector[0], nullptr);
@@ -334,6 +270,7 @@ void MainWindow::changeToMods()
 
     // Clear the other type just to be safe
     storedIDataVector.clear();
+    rebuildSearchIndex();
 
     if (!storedIModDataVector.isEmpty()) {
         ItemWidget dummy(storedIModDataVector[0], nullptr);
@@ -441,7 +378,7 @@ QWidget *MainWindow::createOverview() {
 
     // 3) Intrinsics: X%
     // Retrieve the categories
-    std::vector<IntrinsicCategory> overviewCategories = GetIntrinsics();
+    const std::vector<IntrinsicCategory>& overviewCategories = CurrentInventory().intrinsics;
 
     // clear old data
     sectionHeaders = {};
@@ -489,10 +426,11 @@ QWidget *MainWindow::createOverview() {
 }
 
 void MainWindow::updateOverview() {
-    int currentRank = GetMasteryRank();
-    int currentXP = GetCurrentXP();
-    int totalXP = extraSpecialXp; //GetCurrentXp sets this if it finds something; like the plexus;
-    LogThis("added extraSpecialXp: " + std::to_string(extraSpecialXp));
+    const InventorySnapshot& inventory = CurrentInventory();
+    int currentRank = inventory.masteryRank;
+    int currentXP = inventory.currentXp;
+    int totalXP = inventory.extraSpecialXp; //xp of items not in the exports; like the plexus;
+    LogThis("added extraSpecialXp: " + std::to_string(inventory.extraSpecialXp));
     int xpForNextRank = GetXPForRank(currentRank + 1);
     int xpForCurrentRank = GetXPForRank(currentRank);
 
@@ -561,7 +499,7 @@ void MainWindow::updateOverview() {
     equipmentField->updateTitle(QString("Equipment: %1%").arg(combinedCompletion, 0, 'f', 1));
 
     // 2) Star Chart: X%
-    MissionSummary summary = GetMissionsSummary();
+    const MissionSummary& summary = inventory.missions;
     // Prepare Normal & Steel Path variables
     int normalCompleted = 0;
     int normalTotal = 0;
@@ -613,7 +551,7 @@ void MainWindow::updateOverview() {
 
     // 3) Intrinsics: X%
     // Retrieve the categories
-    std::vector<IntrinsicCategory> overviewCategories = GetIntrinsics();
+    const std::vector<IntrinsicCategory>& overviewCategories = inventory.intrinsics;
 
     // clear old data
     sectionHeaders = {};
@@ -661,6 +599,34 @@ void MainWindow::updateOverview() {
     xpToMaxBar->setValue(currentXP);
 }
 
+//names, the names of a container's parts/rewards and the filter labels of the categories; indices match the stored vectors
+void MainWindow::rebuildSearchIndex()
+{
+    const auto addCategories = [this](InventoryCategories cat) {
+        for (const auto& option : categories) {
+            if (hasCategory(cat, option.value)) {
+                //the labels may carry an explanation in brackets, only the label itself is searchable
+                searchIndex.addText(option.name.section(" (", 0, 0).toStdString(), SearchField::Category);
+            }
+        }
+    };
+
+    searchIndex.clear();
+    for (const IDataContainer* data : storedIDataVector) {
+        searchIndex.addItem();
+        searchIndex.addText(data->getMainData().getName(), SearchField::Name);
+        for (const IData& subData : data->getSubData()) {
+            searchIndex.addText(subData.getName(), SearchField::Part);
+        }
+        addCategories(data->getMainData().getCategory());
+    }
+    for (const IModData* data : storedIModDataVector) {
+        searchIndex.addItem();
+        searchIndex.addText(data->getName(), SearchField::Name);
+        addCategories(data->getCategory());
+    }
+}
+
 // ReSharper disable once CppPassValueParameterByConstReference
 void MainWindow::updateLazyLoading(const QSize dummySize, const QStringList specialTags)
 {
@@ -679,20 +645,22 @@ void MainWindow::updateLazyLoading(const QSize dummySize, const QStringList spec
         isIData = false;
     }
 
-    //apply filters
+    //apply filters, the search index hands out the matches best first and only those get their category checked
+    const InventoryCategories include = includeComboBox->getSelectedCategories();
+    const InventoryCategories exclude = excludeComboBox->getSelectedCategories();
     filteredIndices.clear();
-    if (isIData) {
-        for (int i = 0; i < storedIDataVector.size(); ++i) {
-            if (IDataContainerFilterFunc(storedIDataVector[i])) {
-                filteredIndices.append(i);
-            }
-        }
-    } else {
-        for (int i = 0; i < storedIModDataVector.size(); ++i) {
-            if (IModDataFilterFunc(storedIModDataVector[i])) {
-                filteredIndices.append(i);
-            }
-        }
+    for (uint32_t i : searchIndex.match(searchBar->text().toStdString())) {
+        const InventoryCategories cat = isIData
+            ? storedIDataVector[static_cast<int>(i)]->getMainData().getCategory()
+            : storedIModDataVector[static_cast<int>(i)]->getCategory();
+
+        if (exclude != InventoryCategories::None && hasCategory(cat, exclude))
+            continue;
+
+        if (include != InventoryCategories::None && !hasCategoryStrict(cat, include))
+            continue;
+
+        filteredIndices.append(static_cast<int>(i));
     }
 
     //check if we have any data at all
@@ -756,6 +724,8 @@ void MainWindow::updateVisibleWidgets()
     int startRow = qMax(0, scrollTop / (itemHeight + spacing) - bufferRows);
     int endRow = qMin(totalRows, startRow + visibleRows + 2 * bufferRows);
 
+    prefetchImages(startRow, endRow, scrollTop);
+
     // Calculate adjusted spacing
     int gaps = columnCount + 1;
     int totalGapsWidth = availableWidth - (columnCount * itemWidth);
@@ -807,6 +777,7 @@ void MainWindow::updateVisibleWidgets()
     // Hide and recycle widgets that are no longer visible
     for (auto it = currentVisibleWidgets.begin(); it != currentVisibleWidgets.end();) {
         if (!visibleIndices.contains(it.key())) {
+            it.value()->cancelImageLoads(); //offscreen now, its queued loads should not use the network
             it.value()->hide();
             widgetPool.append(it.value());
             it = currentVisibleWidgets.erase(it);
@@ -817,6 +788,47 @@ void MainWindow::updateVisibleWidgets()
 
 }
 
+// Queues the images of the loaded rows and of the rows the scroll is heading to, so they are there by the
+// time a widget shows them. Rows inside the viewport first, then the buffer band, then the ones ahead.
+void MainWindow::prefetchImages(int startRow, int endRow, int scrollTop) {
+    const int aheadRows = 3;
+    const int rowHeight = itemHeight + spacing;
+    const int firstVisibleRow = scrollTop / rowHeight;
+    const int lastVisibleRow = (scrollTop + scrollArea->viewport()->height()) / rowHeight;
+
+    int aheadStart = endRow;
+    int aheadEnd = qMin(totalRows, endRow + aheadRows);
+    if (scrollTop < lastScrollTop) {
+        aheadStart = qMax(0, startRow - aheadRows);
+        aheadEnd = startRow;
+    }
+    lastScrollTop = scrollTop;
+
+    const bool saveDownload = getWindowSettings().saveDownload;
+    const int dataSize = static_cast<int>(filteredIndices.size());
+    auto prefetchRow = [&](int row, ImagePriority priority) {
+        for (int col = 0; col < columnCount; ++col) {
+            int visibleIndex = row * columnCount + col;
+            if (visibleIndex >= dataSize) break;
+            int actualIndex = filteredIndices[visibleIndex];
+            if (isIData) {
+                ItemWidget::prefetchImages(*storedIDataVector[actualIndex], priority, saveDownload);
+            } else {
+                ItemWidget::prefetchImages(*storedIModDataVector[actualIndex], priority, saveDownload);
+            }
+        }
+    };
+
+    ImageScheduler::instance().beginPass();
+    for (int row = startRow; row < endRow; ++row) {
+        const bool visible = row >= firstVisibleRow && row <= lastVisibleRow;
+        prefetchRow(row, visible ? ImagePriority::Visible : ImagePriority::Buffer);
+    }
+    for (int row = aheadStart; row < aheadEnd; ++row) {
+        prefetchRow(row, ImagePriority::Ahead);
+    }
+}
+
 //Mutex to be extra safe; i think its actually needed, given the user can modify them at any time
 Settings MainWindow::getWindowSettings() {
     std::lock_guard lock(settingsMutex);
@@ -861,11 +873,21 @@ QWidget* MainWindow::createOptionsPage() {
     saveDownloadsCheckbox->setChecked(settings.saveDownload);
     performanceLayout->addWidget(saveDownloadsCheckbox);
 
+    auto compactImagesCheckbox = new QCheckBox("Compress saved Pictures as WebP (slightly lossy, applies after restart)", performanceGroup);
+    compactImagesCheckbox->setChecked(settings.compactImages);
+    compactImagesCheckbox->setEnabled(CompactImageEncodingAvailable());
+    performanceLayout->addWidget(compactImagesCheckbox);
+
     connect(saveDownloadsCheckbox, &QCheckBox::toggled, this, [=](bool checked) {
         settings.saveDownload = checked;
         WriteSettings(settings);
     });
 
+    connect(compactImagesCheckbox, &QCheckBox::toggled, this, [=](bool checked) {
+        settings.compactImages = checked;
+        WriteSettings(settings);
+    });
+
     // ---------- Bottom-Left: Data Input ----------
     auto* dataGroup = new QGroupBox("Warframe Data", page);
     auto* dataLayout = new QVBoxLayout(dataGroup);
@@ -886,7 +908,7 @@ QWidget* MainWindow::createOptionsPage() {
     auto authTokenInput = new QLineEdit(dataGroup);
     authTokenInput->setPlaceholderText("will try to download your inv. data by link: 'api.warframe.com/api/inventory.php?accountId=' + this string");
 
-    auto gameUpdateBtn = new QPushButton("Update Game Data", dataGroup);
+    gameUpdateBtn = new QPushButton("Update Game Data", dataGroup);
     gameUpdateBtn->setStyleSheet(btnStyle);
 
     auto* inputLayout = new QHBoxLayout();
@@ -907,7 +929,7 @@ QWidget* MainWindow::createOptionsPage() {
     auto autoSyncCheckbox = new QCheckBox("Enable Auto Inventory Sync", automationGroup);
     autoSyncCheckbox->setChecked(settings.autoSync);
 
-    auto manualSyncBtn = new QPushButton("Sync inventory", dataGroup);
+    syncBtn = new QPushButton("Sync inventory", dataGroup);
 
     auto intervalLabel = new QLabel("Auto-Sync Interval (minutes):", automationGroup);
     auto intervalSpinBox = new QSpinBox(automationGroup);
@@ -916,7 +938,7 @@ QWidget* MainWindow::createOptionsPage() {
 
     automationLayout->addWidget(autoStartCheckbox);
     automationLayout->addWidget(autoSyncCheckbox);
-    automationLayout->addWidget(manualSyncBtn);
+    automationLayout->addWidget(syncBtn);
     automationLayout->addWidget(intervalLabel);
     automationLayout->addWidget(intervalSpinBox);
 
@@ -950,7 +972,7 @@ QWidget* MainWindow::createOptionsPage() {
         WriteSettings(settings);
     });
 
-    connect(manualSyncBtn, &QPushButton::clicked, this, &MainWindow::updatePlayerData);
+    connect(syncBtn, &QPushButton::clicked, this, &MainWindow::requestSync);
 
     // ---------- Final Layout Assembly ----------
     gridLayout->addWidget(visualGroup, 0, 0);
@@ -979,30 +1001,76 @@ void MainWindow::onFilterChanged()
 
 
 void MainWindow::updateGameData() {
-    FetchGameUpdate();
-    recipes.clear();
-    relics.clear();
-    arcanes.clear();
-    mods.clear();
-    RefreshImgMap();
-    RefreshNameMap();
-    RefreshResultBpMap();
+    if (gameUpdateRunning) return; //the button is disabled meanwhile
+    if (syncRunning) {
+        LogThis("Game data update waits for the running inventory sync");
+        gameUpdateQueued = true;
+        gameUpdateBtn->setEnabled(false);
+        gameUpdateBtn->setText("Update Game Data (waiting for inventory sync)");
+        return;
+    }
+    gameUpdateQueued = false;
+    gameUpdateRunning = true;
+    gameUpdateBtn->setEnabled(false);
+    gameUpdateBtn->setText("Updating Game Data...");
+
+    //downloads run in the background, only the map refresh afterwards has to happen on the UI thread
+    QPointer window = this;
+    (void) QtConcurrent::run([window]() {
+        GameUpdateResult result = FetchGameUpdate([window](size_t done, size_t total) {
+            QMetaObject::invokeMethod(window, [window, done, total]() {
+                if (!window) return;
+                window->gameUpdateBtn->setText(QString("Updating Game Data... %1/%2").arg(done).arg(total));
+            }, Qt::QueuedConnection);
+        });
+
+        QMetaObject::invokeMethod(window, [window, result]() {
+            if (!window) return;
+            window->gameUpdateRunning = false;
+            window->gameUpdateBtn->setEnabled(true);
+            window->gameUpdateBtn->setText(result.success ? "Update Game Data" : "Update Game Data (last update failed)");
+
+            //only what was built from a replaced export gets dropped, the rest stays loaded
+            if (CatalogDependsOn(CatalogKind::Recipes, result.changed)) window->recipes.clear();
+            if (CatalogDependsOn(CatalogKind::Relics, result.changed)) window->relics.clear();
+            if (CatalogDependsOn(CatalogKind::Arcanes, result.changed)) window->arcanes.clear();
+            if (CatalogDependsOn(CatalogKind::Mods, result.changed)) window->mods.clear();
+            RefreshGameDataMaps(result.changed);
+
+            if (window->syncQueued) window->requestSync();
+        }, Qt::QueuedConnection);
+    });
 }
 
-//TODO: last thing to do before alpha test: test this
-void MainWindow::updatePlayerData(bool skipFetch) {
-    LogThis("Updating data");
-    if (!skipFetch) {
-        bool success = UpdatePlayerData(settings.nonce); //TODO: maybe do something on fail idk put a warning banner up
-        if (!success) {
-            LogThis("player data failed to download; check if auth is set correctly");
-        }
-        RefreshCountMap();
-        RefreshUpgradeMap();
+void MainWindow::requestSync() {
+    //a game update swaps the game data maps on this thread, the sync reads them on the worker; never both
+    if (!backgroundWorker) return;
+    if (syncRunning) {
+        LogThis("Inventory sync skipped: a sync is already running");
+        return;
+    }
+    if (gameUpdateRunning) {
+        if (!syncQueued) LogThis("Inventory sync waits for the running game data update");
+        syncQueued = true;
+        if (syncBtn) syncBtn->setText("Sync inventory (waiting for game data update)");
+        return;
     }
+    syncQueued = false;
+    syncRunning = true;
+    if (syncBtn) {
+        syncBtn->setEnabled(false);
+        syncBtn->setText("Syncing inventory...");
+    }
+    EnsureGameDataMaps();
 
-    RefreshXPMap();
+    QMetaObject::invokeMethod(backgroundWorker, &BackgroundWorker::syncInventory, Qt::QueuedConnection);
+}
 
+void MainWindow::applyInventory(std::shared_ptr<const InventorySnapshot> snapshot) {
+    LogThis("Updating data");
+    ApplyInventorySnapshot(std::move(snapshot));
+
+    //only lookups into the new snapshot from here on, no file or network access
     // Update recipes (IDataContainer)
     for (Recipe& recipe : recipes) {
         UpdateCounts(recipe, /*isRelic=*/false);
@@ -1024,6 +1092,13 @@ void MainWindow::updatePlayerData(bool skipFetch) {
     }
 
     updateOverview();
+    syncRunning = false;
+    if (syncBtn) {
+        syncBtn->setEnabled(true);
+        syncBtn->setText("Sync inventory");
+    }
+
+    if (gameUpdateQueued) updateGameData();
 }
 
 MainWindow::~MainWindow() {
@@ -10,6 +10,7 @@
 #include "ItemWidget.h"
 #include "overviewPartWidget.h"
 #include "background/BackgroundWorker.h"
+#include "dataReader/searchIndex.h"
 #include "FileAccess/FileAccess.h"
 
 QT_BEGIN_NAMESPACE
@@ -27,7 +28,10 @@ public:
 
     QWidget *createLazyLoadingPage();
     static Settings getWindowSettings();
-    void updatePlayerData(bool skipFetch = false);
+
+    //starts a background sync of the player data; the result comes back through applyInventory
+    void requestSync();
+    void applyInventory(std::shared_ptr<const InventorySnapshot> snapshot);
 
     ~MainWindow() override;
 
@@ -46,6 +50,13 @@ private:
     FilterWidget* includeComboBox{};
     FilterWidget* excludeComboBox{};
     QLineEdit* searchBar{};
+    QPushButton* gameUpdateBtn = nullptr;
+    QPushButton* syncBtn = nullptr;
+    bool gameUpdateRunning = false;
+    bool syncRunning = false;
+    //the game update and a sync never run together, one asked for during the other starts when it is done
+    bool gameUpdateQueued = false;
+    bool syncQueued = false;
 
     QLabel* xpToMasteryLabel = nullptr;
     QProgressBar* xpToMasteryBar = nullptr;
@@ -60,6 +71,7 @@ private:
     int columnCount = 1;
     int spacing = 6;
     int totalRows = 0;
+    int lastScrollTop = 0; //to tell which way the user scrolls
     QSize lastUsedSize = QSize();
     QStringList lastUsedTags = QStringList();
     bool isIData = false;
@@ -74,9 +86,7 @@ private:
     QVector<IDataContainer*> storedIDataVector;
     QVector<IModData*> storedIModDataVector;
 
-    // Filter functions
-    std::function<bool(const IDataContainer*)> IDataContainerFilterFunc;
-    std::function<bool(const IModData*)> IModDataFilterFunc;
+    SearchIndex searchIndex; //over whichever stored vector is filled, rebuilt when the page changes
 
     std::vector<Recipe> recipes; //this is important otherwise these get deleted after creation and all filtering etc. causes invalid access violation
     std::vector<Relic> relics;
@@ -143,6 +153,8 @@ private:
 
     void changeToMods();
 
+    void rebuildSearchIndex();
+
     void updateLazyLoading(QSize dummySize, QStringList specialTags);
 
     QWidget *createOptionsPage();
@@ -155,5 +167,7 @@ protected:
 
     void updateVisibleWidgets();
 
+    void prefetchImages(int startRow, int endRow, int scrollTop);
+
 };
 #endif // MAINWINDOW_H